@@ -0,0 +1,72 @@
+#ifndef CXC_BENCH_H
+#define CXC_BENCH_H
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace cxc::bench
+{
+
+/**
+ * @brief Keeps the compiler from optimizing away a computed value.
+ *
+ * @tparam T The type of the value.
+ * @param value The value that must be considered used.
+ */
+template <typename T> inline void keep(T const &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Runs a benchmark body several times and returns the best time per
+ * operation.
+ *
+ * @tparam Fn The type of the benchmark body.
+ * @param ops The number of operations performed by one run of the body.
+ * @param fn The benchmark body.
+ * @param runs The number of runs, the fastest one is kept.
+ * @return The fastest run's nanoseconds per operation.
+ */
+template <typename Fn> double ns_per_op(size_t ops, Fn &&fn, int runs = 5)
+{
+    double best = 0;
+
+    for (int i = 0; i < runs; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(ops);
+
+        if (i == 0 || ns < best)
+            best = ns;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Prints one benchmark result line.
+ *
+ * @param name The name of the benchmark.
+ * @param ns The nanoseconds per operation.
+ */
+inline void report(const std::string &name, double ns)
+{
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(2) << ns << " ns/op" << std::endl;
+}
+
+} // namespace cxc::bench
+
+#endif
@@ -0,0 +1,155 @@
+#include "bench.h"
+#include "cache.h"
+#include "dlist.h"
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Get-or-put over a Zipfian key stream (s = 0.99) with lru_cache, lfu_cache,
+// a std::list + unordered_map LRU and the hand-rolled dlist LRU that moves a
+// hit to the front with remove_at / insert_head.
+
+std::vector<long> zipf_stream(size_t keys, size_t count, double s)
+{
+    std::vector<double> cdf(keys);
+    double total = 0;
+
+    for (size_t i = 0; i < keys; i++)
+    {
+        total += 1.0 / std::pow(static_cast<double>(i + 1), s);
+        cdf[i] = total;
+    }
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> uniform(0, total);
+    std::vector<long> stream(count);
+
+    for (long &key : stream)
+        key = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+
+    return stream;
+}
+
+template <typename Cache> void run(const std::string &name, const std::vector<long> &stream, size_t capacity)
+{
+    size_t hits = 0;
+
+    double ns = cxc::bench::ns_per_op(
+        stream.size(),
+        [&]() {
+            Cache cache(capacity);
+            hits = 0;
+
+            for (long key : stream)
+            {
+                if (cache.get(key) != nullptr)
+                    hits++;
+                else
+                    cache.put(key, key * 2);
+            }
+        },
+        3);
+
+    double ratio = 100.0 * static_cast<double>(hits) / static_cast<double>(stream.size());
+    cxc::bench::report(name + " hits " + std::to_string(static_cast<int>(ratio)) + "%", ns);
+}
+
+// the usual hand-written LRU: std::list for the order, a map to its nodes
+struct std_lru
+{
+    size_t capacity;
+    std::list<std::pair<long, long>> order;
+    std::unordered_map<long, std::list<std::pair<long, long>>::iterator> map;
+
+    explicit std_lru(size_t _capacity) : capacity(_capacity)
+    {
+    }
+
+    long *get(long key)
+    {
+        auto found = map.find(key);
+
+        if (found == map.end())
+            return nullptr;
+
+        order.splice(order.begin(), order, found->second);
+        return &found->second->second;
+    }
+
+    void put(long key, long value)
+    {
+        if (map.size() == capacity)
+        {
+            map.erase(order.back().first);
+            order.pop_back();
+        }
+
+        order.emplace_front(key, value);
+        map.emplace(key, order.begin());
+    }
+};
+
+// the pattern lru_cache replaces: a hit is found by walking to its position
+struct positional_lru
+{
+    size_t capacity;
+    cxc::dlist<std::pair<long, long>> order{};
+    std::unordered_map<long, cxc::Node<std::pair<long, long>> *> map;
+
+    explicit positional_lru(size_t _capacity) : capacity(_capacity)
+    {
+    }
+
+    long *get(long key)
+    {
+        auto found = map.find(key);
+
+        if (found == map.end())
+            return nullptr;
+
+        size_t position = 0;
+
+        for (auto it = order.begin(); it.get_addr() != found->second; ++it)
+            position++;
+
+        std::pair<long, long> entry = found->second->data;
+        order.remove_at(position);
+        order.insert_head(entry);
+        found->second = order.get_node(0);
+
+        return &found->second->data.second;
+    }
+
+    void put(long key, long value)
+    {
+        if (map.size() == capacity)
+        {
+            map.erase(order.get_tail().first);
+            order.remove_tail();
+        }
+
+        order.insert_head({key, value});
+        map.emplace(key, order.get_node(0));
+    }
+};
+
+int main()
+{
+    size_t keys = 1000000;
+    size_t capacity = 100000;
+    std::vector<long> stream = zipf_stream(keys, 2000000, 0.99);
+
+    std::string suffix = " cap=" + std::to_string(capacity) + " n=" + std::to_string(stream.size());
+
+    run<cxc::lru_cache<long, long>>("lru_cache" + suffix, stream, capacity);
+    run<cxc::lfu_cache<long, long>>("lfu_cache" + suffix, stream, capacity);
+    run<std_lru>("std::list + unordered_map" + suffix, stream, capacity);
+
+    // walks the list on every hit, so only a short stream
+    std::vector<long> head(stream.begin(), stream.begin() + 20000);
+    run<positional_lru>("dlist remove_at / insert_head n=20000", head, capacity);
+}
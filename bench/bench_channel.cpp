@@ -0,0 +1,158 @@
+#include "bench.h"
+#include "channel.h"
+#include "dlist.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// Round trip latency between two pipeline stages: a value goes to the other
+// stage and comes back. Coroutines over two channels resume each other on one
+// thread; the baseline is two threads handing values over mutex-guarded
+// dlists and condition variables, and the polling loop it replaces.
+
+// coroutine that starts at once and frees itself when done
+struct detached
+{
+    struct promise_type
+    {
+        detached get_return_object()
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend()
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+detached echo(cxc::channel<long> &in, cxc::channel<long> &out)
+{
+    while (auto value = co_await in.pop())
+        co_await out.push(*value);
+}
+
+detached ping(cxc::channel<long> &out, cxc::channel<long> &in, size_t rounds, long &sum)
+{
+    for (size_t i = 0; i < rounds; i++)
+    {
+        co_await out.push(static_cast<long>(i));
+        sum += *co_await in.pop();
+    }
+
+    out.close();
+}
+
+double run_channel(size_t rounds, size_t capacity)
+{
+    return cxc::bench::ns_per_op(rounds, [&]() {
+        cxc::channel<long> there(capacity);
+        cxc::channel<long> back(capacity);
+        long sum = 0;
+
+        echo(there, back);
+        ping(there, back, rounds, sum);
+
+        cxc::bench::keep(sum);
+    });
+}
+
+struct locked_queue
+{
+    std::mutex lock;
+    std::condition_variable ready;
+    cxc::dlist<long> items{};
+
+    void push(long value)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            items.insert_tail(value);
+        }
+
+        ready.notify_one();
+    }
+
+    long pop()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ready.wait(guard, [this]() { return !items.is_empty(); });
+
+        long value = items.get_head();
+        items.remove_head();
+
+        return value;
+    }
+
+    // the is_empty() polling with sleeps that the channel replaces
+    long poll()
+    {
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+
+                if (!items.is_empty())
+                {
+                    long value = items.get_head();
+                    items.remove_head();
+                    return value;
+                }
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+};
+
+template <bool Poll> double run_threads(size_t rounds)
+{
+    return cxc::bench::ns_per_op(rounds, [&]() {
+        locked_queue there;
+        locked_queue back;
+
+        std::thread other([&]() {
+            for (size_t i = 0; i < rounds; i++)
+                back.push(Poll ? there.poll() : there.pop());
+        });
+
+        long sum = 0;
+
+        for (size_t i = 0; i < rounds; i++)
+        {
+            there.push(static_cast<long>(i));
+            sum += Poll ? back.poll() : back.pop();
+        }
+
+        other.join();
+        cxc::bench::keep(sum);
+    });
+}
+
+int main()
+{
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    cxc::bench::report("round trip channel capacity=0", run_channel(1000000, 0));
+    cxc::bench::report("round trip channel capacity=16", run_channel(1000000, 16));
+    cxc::bench::report("round trip condition_variable", run_threads<false>(100000));
+    cxc::bench::report("round trip polling, 50us sleep", run_threads<true>(2000));
+}
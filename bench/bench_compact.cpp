@@ -0,0 +1,57 @@
+#include "bench.h"
+#include "compact_dlist.h"
+#include "dlist.h"
+
+#include <iostream>
+
+// Building and summing a list of floats with pointer-linked nodes against the
+// 32-bit index links of compact_dlist, plus the memory each layout takes.
+
+template <typename List> double build(size_t count)
+{
+    return cxc::bench::ns_per_op(count, [&]() {
+        List list{};
+
+        for (size_t i = 0; i < count; i++)
+            list.insert_tail(static_cast<float>(i));
+
+        cxc::bench::keep(list.size());
+    });
+}
+
+template <typename List> double sum(size_t count)
+{
+    List list{};
+
+    for (size_t i = 0; i < count; i++)
+        list.insert_tail(static_cast<float>(i));
+
+    return cxc::bench::ns_per_op(count, [&]() {
+        float total = 0;
+
+        for (float value : list)
+            total += value;
+
+        cxc::bench::keep(total);
+    });
+}
+
+int main()
+{
+    size_t count = 5000000;
+
+    cxc::bench::report("dlist<float> insert_tail", build<cxc::dlist<float>>(count));
+    cxc::bench::report("compact_dlist<float> insert_tail", build<cxc::compact_dlist<float>>(count));
+    cxc::bench::report("compact_dlist<float, xor_links> insert_tail",
+                       build<cxc::compact_dlist<float, cxc::xor_links>>(count));
+
+    cxc::bench::report("dlist<float> iterate", sum<cxc::dlist<float>>(count));
+    cxc::bench::report("compact_dlist<float> iterate", sum<cxc::compact_dlist<float>>(count));
+    cxc::bench::report("compact_dlist<float, xor_links> iterate",
+                       sum<cxc::compact_dlist<float, cxc::xor_links>>(count));
+
+    std::cout << "bytes per element: Node<float> " << sizeof(cxc::Node<float>) << " (+ malloc header with "
+              << "heap_allocator), compact_dlist<float> " << cxc::compact_dlist<float>::slot_size()
+              << ", compact_dlist<float, xor_links> " << cxc::compact_dlist<float, cxc::xor_links>::slot_size()
+              << std::endl;
+}
@@ -0,0 +1,71 @@
+#include "bench.h"
+#include "concurrent_dlist.h"
+#include "dlist.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Producers and consumers hammering both ends of one deque: the lock-free
+// concurrent_dlist against a dlist behind a std::mutex. Half of the threads
+// push at the tail, the other half pop at the head.
+
+template <typename Push, typename Pop> void run(size_t threads, size_t per_thread, Push push, Pop pop)
+{
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]() {
+            for (size_t i = 0; i < per_thread; i++)
+            {
+                if (t % 2 == 0)
+                    push(static_cast<int>(i));
+                else
+                    pop();
+            }
+        });
+    }
+
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+int main()
+{
+    size_t ops = 400000;
+
+    for (size_t threads : {1, 2, 4, 8, 16, 32, 64})
+    {
+        size_t per_thread = ops / threads;
+
+        double lock_free = cxc::bench::ns_per_op(per_thread * threads, [&]() {
+            cxc::concurrent_dlist<int> deque{};
+
+            run(
+                threads, per_thread, [&](int value) { deque.insert_tail(value); },
+                [&]() { cxc::bench::keep(deque.pop_head()); });
+        });
+
+        double locked = cxc::bench::ns_per_op(per_thread * threads, [&]() {
+            cxc::dlist<int> list{};
+            std::mutex mutex;
+
+            run(
+                threads, per_thread,
+                [&](int value) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    list.insert_tail(value);
+                },
+                [&]() {
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    if (!list.is_empty())
+                        list.remove_head();
+                });
+        });
+
+        cxc::bench::report("concurrent_dlist threads=" + std::to_string(threads), lock_free);
+        cxc::bench::report("dlist + std::mutex threads=" + std::to_string(threads), locked);
+    }
+}
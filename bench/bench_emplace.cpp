@@ -0,0 +1,56 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <string>
+#include <vector>
+
+// Insertion of a heavyweight payload by copy, by move and constructed in
+// place.
+
+struct Payload
+{
+    std::string name;
+    std::vector<double> values;
+
+    Payload(const std::string &_name, size_t count) : name(_name), values(count, 1.0)
+    {
+    }
+};
+
+int main()
+{
+    size_t count = 100000;
+    std::string name(64, 'x');
+    Payload prototype(name, 32);
+
+    double copy = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<Payload> list{};
+
+        for (size_t i = 0; i < count; i++)
+            list.insert_tail(prototype);
+
+        cxc::bench::keep(list.size());
+    });
+
+    double move = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<Payload> list{};
+
+        for (size_t i = 0; i < count; i++)
+            list.insert_tail(Payload(name, 32));
+
+        cxc::bench::keep(list.size());
+    });
+
+    double emplace = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<Payload> list{};
+
+        for (size_t i = 0; i < count; i++)
+            list.emplace_tail(name, 32);
+
+        cxc::bench::keep(list.size());
+    });
+
+    cxc::bench::report("insert_tail(const Payload &)", copy);
+    cxc::bench::report("insert_tail(Payload &&)", move);
+    cxc::bench::report("emplace_tail(name, 32)", emplace);
+}
@@ -0,0 +1,52 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <vector>
+
+// Single-pass filtering of a list: erase(Iterator) against remove_at, which
+// needs the element's position and walks to it again.
+
+int main()
+{
+    size_t count = 20000;
+    std::vector<int> values(count);
+
+    for (size_t i = 0; i < count; i++)
+        values[i] = static_cast<int>(i);
+
+    double by_iterator = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<int> list{};
+        list.append_range(values.begin(), values.end());
+
+        for (auto it = list.begin(); it != list.end();)
+            it = *it % 2 != 0 ? list.erase(it) : ++it;
+
+        cxc::bench::keep(list.size());
+    });
+
+    double by_position = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<int> list{};
+        list.append_range(values.begin(), values.end());
+
+        size_t position = 0;
+
+        for (auto it = list.begin(); it != list.end();)
+        {
+            if (*it % 2 != 0)
+            {
+                ++it;
+                list.remove_at(position);
+            }
+            else
+            {
+                ++it;
+                position++;
+            }
+        }
+
+        cxc::bench::keep(list.size());
+    });
+
+    cxc::bench::report("erase(it) filter n=" + std::to_string(count), by_iterator);
+    cxc::bench::report("remove_at(i) filter n=" + std::to_string(count), by_position);
+}
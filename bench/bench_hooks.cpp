@@ -0,0 +1,35 @@
+#include "bench.h"
+#include "dlist.h"
+
+// Insert / remove throughput of the inline size_hooks against event_hooks,
+// which dispatches every mutation through EventListener like dlist used to.
+
+template <typename List> void churn(size_t count)
+{
+    List list{};
+
+    for (size_t i = 0; i < count; i++)
+        list.insert_tail(static_cast<int>(i));
+
+    for (size_t i = 0; i < count; i++)
+        list.remove_head();
+
+    cxc::bench::keep(list.size());
+}
+
+int main()
+{
+    using inline_list = cxc::dlist<int>;
+    using event_list = cxc::dlist<int, cxc::node_pool<int>, cxc::event_hooks>;
+
+    for (size_t count : {1000, 100000, 1000000})
+    {
+        std::string suffix = " n=" + std::to_string(count);
+
+        double events = cxc::bench::ns_per_op(2 * count, [count]() { churn<event_list>(count); });
+        double hooks = cxc::bench::ns_per_op(2 * count, [count]() { churn<inline_list>(count); });
+
+        cxc::bench::report("insert+remove event_hooks" + suffix, events);
+        cxc::bench::report("insert+remove size_hooks" + suffix, hooks);
+    }
+}
@@ -0,0 +1,47 @@
+#include "bench.h"
+#include "dlist.h"
+#include "huge_pages.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Traversal of a large list whose node order is shuffled against memory
+// order, so every step lands on another page, with slabs from the heap and
+// from transparent huge pages. Also reports how much of the list the kernel
+// placed on huge pages.
+
+template <typename List> void run(const std::string &name, size_t count)
+{
+    std::vector<long> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::mt19937_64(42));
+
+    List list{};
+
+    for (long value : values)
+        list.insert_tail(value);
+
+    // sorting relinks the nodes in an order unrelated to their addresses
+    list.sort();
+
+    auto scan = [&]() { cxc::bench::keep(std::accumulate(list.begin(), list.end(), 0L)); };
+
+    std::string suffix = " " + name + " n=" + std::to_string(count);
+    cxc::bench::report("shuffled scan" + suffix, cxc::bench::ns_per_op(count, scan, 3));
+
+    size_t total = list.get_allocator().footprint(count);
+    size_t huge = list.get_allocator().huge_page_bytes();
+
+    std::cout << "    " << (huge >> 20) << " of " << (total >> 20) << " MiB on huge pages" << std::endl;
+}
+
+int main()
+{
+    for (size_t count : {size_t(1) << 20, size_t(1) << 24})
+    {
+        run<cxc::dlist<long>>("heap_slabs", count);
+        run<cxc::dlist<long, cxc::huge_page_pool<long>>>("huge_page_slabs", count);
+    }
+}
@@ -0,0 +1,66 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <random>
+
+// Random-position change() / insert_at() / remove_at(), and erase() /
+// insert_before() at iterators found by get_node(), with the default
+// linear_index against skip_index.
+
+template <typename List> void positional(const std::string &name, size_t count, size_t ops)
+{
+    List list{};
+
+    for (size_t i = 0; i < count; i++)
+        list.insert_tail(static_cast<int>(i));
+
+    std::mt19937_64 rng(42);
+
+    double change = cxc::bench::ns_per_op(
+        ops,
+        [&]() {
+            for (size_t i = 0; i < ops; i++)
+                list.change(rng() % list.size(), static_cast<int>(i));
+        },
+        3);
+
+    double churn = cxc::bench::ns_per_op(
+        2 * ops,
+        [&]() {
+            for (size_t i = 0; i < ops; i++)
+            {
+                list.insert_at(rng() % list.size(), static_cast<int>(i));
+                list.remove_at(rng() % list.size());
+            }
+        },
+        3);
+
+    using Iterator = typename List::Iterator;
+
+    double local = cxc::bench::ns_per_op(
+        2 * ops,
+        [&]() {
+            for (size_t i = 0; i < ops; i++)
+            {
+                list.erase(Iterator(list.get_node(rng() % list.size())));
+                list.insert_before(Iterator(list.get_node(rng() % list.size())), static_cast<int>(i));
+            }
+        },
+        3);
+
+    std::string suffix = " n=" + std::to_string(count);
+    cxc::bench::report(name + " change" + suffix, change);
+    cxc::bench::report(name + " insert_at+remove_at" + suffix, churn);
+    cxc::bench::report(name + " get_node+erase/insert_before" + suffix, local);
+}
+
+int main()
+{
+    using skip_list = cxc::dlist<int, cxc::node_pool<int>, cxc::size_hooks, cxc::skip_index<int>>;
+
+    for (size_t count : {1000, 1000000})
+    {
+        positional<cxc::dlist<int>>("linear_index", count, count >= 1000000 ? 200 : 10000);
+        positional<skip_list>("skip_index", count, 100000);
+    }
+}
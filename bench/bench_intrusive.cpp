@@ -0,0 +1,56 @@
+#include "bench.h"
+#include "dlist.h"
+#include "intrusive_dlist.h"
+
+#include <vector>
+
+// Moving sessions to the back of an LRU order: an intrusive_dlist relinks the
+// object in place, a dlist of pointers allocates a node per move and has to
+// find the element first (here the head, its cheapest case).
+
+struct Session : cxc::dlist_hook<>
+{
+    int id = 0;
+};
+
+int main()
+{
+    size_t count = 100000;
+    size_t moves = 1000000;
+    std::vector<Session> sessions(count);
+
+    double intrusive = cxc::bench::ns_per_op(moves, [&]() {
+        cxc::intrusive_dlist<Session> lru{};
+
+        for (Session &session : sessions)
+            lru.insert_tail(session);
+
+        for (size_t i = 0; i < moves; i++)
+        {
+            Session &session = lru.get_head();
+            lru.remove(session);
+            lru.insert_tail(session);
+        }
+
+        cxc::bench::keep(lru.size());
+    });
+
+    double allocating = cxc::bench::ns_per_op(moves, [&]() {
+        cxc::dlist<Session *, cxc::heap_allocator<Session *>> lru{};
+
+        for (Session &session : sessions)
+            lru.insert_tail(&session);
+
+        for (size_t i = 0; i < moves; i++)
+        {
+            Session *session = lru.get_head();
+            lru.remove_head();
+            lru.insert_tail(session);
+        }
+
+        cxc::bench::keep(lru.size());
+    });
+
+    cxc::bench::report("intrusive_dlist remove + insert_tail", intrusive);
+    cxc::bench::report("dlist<T*, heap_allocator> remove + insert_tail", allocating);
+}
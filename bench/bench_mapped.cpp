@@ -0,0 +1,69 @@
+#include "bench.h"
+#include "dlist.h"
+#include "mapped_dlist.h"
+
+#include <cstdio>
+#include <fstream>
+
+// Reopening a list kept in a mapped file and walking it, against loading the
+// same list from a binary dump. The mapped list has no load step, only the
+// page faults of the first walk.
+
+int main()
+{
+    size_t count = 2000000;
+    std::string mapped_path = "bench_mapped.bin";
+    std::string dump_path = "bench_mapped.dump";
+
+    std::remove(mapped_path.c_str());
+
+    double build = 0;
+    {
+        cxc::mapped_dlist<long> list(mapped_path);
+
+        build = cxc::bench::ns_per_op(
+            count,
+            [&]() {
+                for (size_t i = 0; i < count; i++)
+                    list.insert_tail(static_cast<long>(i));
+            },
+            1);
+
+        cxc::dlist<long> source{};
+
+        for (long value : list)
+            source.insert_tail(value);
+
+        std::ofstream out(dump_path, std::ios::binary);
+        source.save(out);
+    }
+
+    double reopen = cxc::bench::ns_per_op(count, [&]() {
+        cxc::mapped_dlist<long> list(mapped_path);
+        long sum = 0;
+
+        for (long value : list)
+            sum += value;
+
+        cxc::bench::keep(sum);
+    });
+
+    double load = cxc::bench::ns_per_op(count, [&]() {
+        std::ifstream in(dump_path, std::ios::binary);
+        cxc::dlist<long> list{};
+        list.load(in);
+        long sum = 0;
+
+        for (long value : list)
+            sum += value;
+
+        cxc::bench::keep(sum);
+    });
+
+    cxc::bench::report("mapped_dlist insert_tail n=" + std::to_string(count), build);
+    cxc::bench::report("mapped_dlist reopen + walk n=" + std::to_string(count), reopen);
+    cxc::bench::report("dlist load + walk n=" + std::to_string(count), load);
+
+    std::remove(mapped_path.c_str());
+    std::remove(dump_path.c_str());
+}
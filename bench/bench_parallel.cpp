@@ -0,0 +1,66 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// std::for_each / std::accumulate over a dlist against par_for_each,
+// par_transform and par_reduce on the process-wide work-stealing pool, for a
+// cheap and a costly per-element function. The speedup is bounded by the
+// number of hardware threads printed first.
+
+template <typename List> void run(const std::string &name, size_t count)
+{
+    List list{};
+
+    for (size_t i = 0; i < count; i++)
+        list.insert_tail(static_cast<double>(i % 1000));
+
+    auto heavy = [](double value) {
+        for (int i = 0; i < 16; i++)
+            value = std::sqrt(value + 1.0);
+
+        return value;
+    };
+
+    std::string suffix = " " + name + " n=" + std::to_string(count);
+
+    double serial_cheap = cxc::bench::ns_per_op(count, [&]() {
+        std::for_each(list.begin(), list.end(), [](double &value) { value = value * 0.5 + 1.0; });
+    });
+
+    double par_cheap = cxc::bench::ns_per_op(count, [&]() {
+        list.par_for_each([](double &value) { value = value * 0.5 + 1.0; });
+    });
+
+    double serial_heavy = cxc::bench::ns_per_op(count, [&]() {
+        std::for_each(list.begin(), list.end(), [&heavy](double &value) { value = heavy(value); });
+    });
+
+    double par_heavy = cxc::bench::ns_per_op(count, [&]() { list.par_transform(heavy); });
+
+    double serial_sum = cxc::bench::ns_per_op(count, [&]() {
+        cxc::bench::keep(std::accumulate(list.begin(), list.end(), 0.0));
+    });
+
+    double par_sum = cxc::bench::ns_per_op(count, [&]() { cxc::bench::keep(list.par_reduce(0.0)); });
+
+    cxc::bench::report("std::for_each (cheap)" + suffix, serial_cheap);
+    cxc::bench::report("par_for_each (cheap)" + suffix, par_cheap);
+    cxc::bench::report("std::for_each (sqrt x16)" + suffix, serial_heavy);
+    cxc::bench::report("par_transform (sqrt x16)" + suffix, par_heavy);
+    cxc::bench::report("std::accumulate" + suffix, serial_sum);
+    cxc::bench::report("par_reduce" + suffix, par_sum);
+}
+
+int main()
+{
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency()
+              << ", pool workers: " << cxc::work_stealing_pool::instance().size() << std::endl;
+
+    size_t count = 4000000;
+
+    run<cxc::dlist<double>>("dlist", count);
+    run<cxc::dlist<double, cxc::node_pool<double>, cxc::size_hooks, cxc::skip_index<double>>>("skip_index", count);
+}
@@ -0,0 +1,79 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+// Walking a list backwards: reverse() twice around a forward walk, as
+// src/main.cpp used to, against reversed() and std::views::reverse. Then a
+// lazy filter | transform | take pipeline against the same work done by
+// copying the filtered elements into a vector first.
+
+static_assert(std::ranges::bidirectional_range<cxc::dlist<long>>);
+static_assert(std::ranges::bidirectional_range<const cxc::dlist<long>>);
+
+int main()
+{
+    size_t count = 1000000;
+    cxc::dlist<long> list{};
+
+    for (size_t i = 0; i < count; i++)
+        list.insert_tail(static_cast<long>(i));
+
+    auto twice = [&]() {
+        list.reverse();
+        cxc::bench::keep(std::accumulate(list.begin(), list.end(), 0L));
+        list.reverse();
+    };
+
+    auto reversed = [&]() {
+        auto view = list.reversed();
+        cxc::bench::keep(std::accumulate(view.begin(), view.end(), 0L));
+    };
+
+    auto views_reverse = [&]() {
+        long sum = 0;
+
+        for (long value : list | std::views::reverse)
+            sum += value;
+
+        cxc::bench::keep(sum);
+    };
+
+    std::string suffix = " n=" + std::to_string(count);
+
+    cxc::bench::report("backward walk, reverse() x2" + suffix, cxc::bench::ns_per_op(count, twice));
+    cxc::bench::report("backward walk, reversed()" + suffix, cxc::bench::ns_per_op(count, reversed));
+    cxc::bench::report("backward walk, views::reverse" + suffix, cxc::bench::ns_per_op(count, views_reverse));
+
+    // the first 1000 odd values times 3, from the tail
+    size_t wanted = 1000;
+
+    auto lazy = [&]() {
+        long sum = 0;
+        auto odd = [](long value) { return value % 2 != 0; };
+        auto triple = [](long value) { return value * 3; };
+
+        for (long value : list | std::views::reverse | std::views::filter(odd) | std::views::transform(triple) |
+                              std::views::take(wanted))
+            sum += value;
+
+        cxc::bench::keep(sum);
+    };
+
+    auto materialized = [&]() {
+        std::vector<long> odd;
+
+        for (auto it = list.rbegin(); it != list.rend(); ++it)
+        {
+            if (*it % 2 != 0)
+                odd.push_back(*it * 3);
+        }
+
+        cxc::bench::keep(std::accumulate(odd.begin(), odd.begin() + static_cast<std::ptrdiff_t>(wanted), 0L));
+    };
+
+    cxc::bench::report("filter | transform | take, lazy", cxc::bench::ns_per_op(wanted, lazy));
+    cxc::bench::report("filter | transform | take, materialized", cxc::bench::ns_per_op(wanted, materialized));
+}
@@ -0,0 +1,112 @@
+#include "bench.h"
+#include "dlist.h"
+#include "rcu_dlist.h"
+
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// Reader threads each sum a list a fixed number of times while one writer
+// thread inserts at the tail and removes at the head until they are done:
+// rcu_dlist against a dlist behind a std::shared_mutex. Reports the wall time
+// per walk of one reader and how much the writer got done meanwhile.
+
+struct locked_list
+{
+    std::shared_mutex lock;
+    cxc::dlist<long> list{};
+
+    long sum()
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        long total = 0;
+
+        for (long value : list)
+            total += value;
+
+        return total;
+    }
+
+    void churn(long value)
+    {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        list.insert_tail(value);
+        list.remove_head();
+    }
+};
+
+struct rcu_list
+{
+    cxc::rcu_dlist<long> list{};
+
+    long sum()
+    {
+        long total = 0;
+
+        for (long value : list)
+            total += value;
+
+        return total;
+    }
+
+    void churn(long value)
+    {
+        list.insert_tail(value);
+        list.remove_head();
+    }
+};
+
+template <typename List> void run(const std::string &name, size_t readers, size_t length, size_t walks)
+{
+    List shared{};
+
+    for (size_t i = 0; i < length; i++)
+        shared.list.insert_tail(static_cast<long>(i));
+
+    std::atomic<size_t> running{readers};
+    size_t writes = 0;
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t r = 0; r < readers; r++)
+    {
+        threads.emplace_back([&]() {
+            for (size_t i = 0; i < walks; i++)
+                cxc::bench::keep(shared.sum());
+
+            running.fetch_sub(1);
+        });
+    }
+
+    // a writer behind a reader-preferring lock may only get in once the
+    // readers are done
+    while (running.load(std::memory_order_relaxed) != 0)
+        shared.churn(static_cast<long>(writes++));
+
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    std::string suffix = " " + name + " readers=" + std::to_string(readers);
+
+    cxc::bench::report("walk" + suffix, ns / static_cast<double>(walks));
+    std::cout << "    " << writes << " inserts + removes meanwhile" << std::endl;
+}
+
+int main()
+{
+    size_t length = 1000;
+    size_t walks = 20000;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (size_t readers : {1, 2, 4, 8})
+    {
+        run<locked_list>("shared_mutex", readers, length, walks);
+        run<rcu_list>("rcu_dlist", readers, length, walks);
+    }
+}
@@ -0,0 +1,70 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Scan speed of a list whose node order was shuffled against memory order,
+// as after a long uptime, before and after relayout(), with plain and
+// prefetching iterators.
+
+template <typename List> void run(const std::string &name, size_t count)
+{
+    // sorting random values relinks the nodes in an order unrelated to the
+    // one they were allocated in
+    std::vector<long> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::mt19937_64(42));
+
+    List list{};
+
+    for (long value : values)
+        list.insert_tail(value);
+
+    list.sort();
+
+    auto scan = [&]() { cxc::bench::keep(std::accumulate(list.begin(), list.end(), 0L)); };
+
+    auto scan_prefetched = [&]() {
+        auto range = list.prefetched(8);
+        cxc::bench::keep(std::accumulate(range.begin(), range.end(), 0L));
+    };
+
+    // a few dozen cycles of work per element, which prefetching can overlap
+    auto work = [](long sum, long value) {
+        for (int i = 0; i < 8; i++)
+            value = value * 6364136223846793005L + 1442695040888963407L;
+
+        return sum ^ value;
+    };
+
+    auto scan_work = [&]() { cxc::bench::keep(std::accumulate(list.begin(), list.end(), 0L, work)); };
+
+    auto scan_work_prefetched = [&]() {
+        auto range = list.prefetched(8);
+        cxc::bench::keep(std::accumulate(range.begin(), range.end(), 0L, work));
+    };
+
+    std::string suffix = " " + name + " n=" + std::to_string(count);
+
+    cxc::bench::report("shuffled scan" + suffix, cxc::bench::ns_per_op(count, scan));
+    cxc::bench::report("shuffled scan, prefetched" + suffix, cxc::bench::ns_per_op(count, scan_prefetched));
+    cxc::bench::report("shuffled scan + work" + suffix, cxc::bench::ns_per_op(count, scan_work));
+    cxc::bench::report("shuffled scan + work, prefetch" + suffix, cxc::bench::ns_per_op(count, scan_work_prefetched));
+
+    cxc::bench::report("relayout" + suffix, cxc::bench::ns_per_op(count, [&]() { list.relayout(); }, 1));
+
+    cxc::bench::report("relaid scan" + suffix, cxc::bench::ns_per_op(count, scan));
+    cxc::bench::report("relaid scan, prefetched" + suffix, cxc::bench::ns_per_op(count, scan_prefetched));
+    cxc::bench::report("relaid scan + work" + suffix, cxc::bench::ns_per_op(count, scan_work));
+}
+
+int main()
+{
+    size_t count = 4000000;
+
+    run<cxc::dlist<long>>("node_pool", count);
+    run<cxc::dlist<long, cxc::heap_allocator<long>>>("heap", count);
+}
@@ -0,0 +1,53 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <sstream>
+
+// Rebuilding a list from a text dump with one insert per element against
+// the binary load, and the matching binary save.
+
+int main()
+{
+    size_t count = 5000000;
+
+    cxc::dlist<int> source{};
+    std::stringstream text;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        source.insert_tail(static_cast<int>(i * 7));
+        text << i * 7 << '\n';
+    }
+
+    std::string dump = text.str();
+    std::string binary;
+
+    double save = cxc::bench::ns_per_op(count, [&]() {
+        std::ostringstream out;
+        source.save(out);
+        binary = out.str();
+    });
+
+    double load = cxc::bench::ns_per_op(count, [&]() {
+        std::istringstream in(binary);
+        cxc::dlist<int> list{};
+        list.load(in);
+
+        cxc::bench::keep(list.size());
+    });
+
+    double parse = cxc::bench::ns_per_op(count, [&]() {
+        std::istringstream in(dump);
+        cxc::dlist<int> list{};
+        int value;
+
+        while (in >> value)
+            list.insert(value);
+
+        cxc::bench::keep(list.size());
+    });
+
+    cxc::bench::report("save (binary) n=" + std::to_string(count), save);
+    cxc::bench::report("load (binary) n=" + std::to_string(count), load);
+    cxc::bench::report("text dump + insert n=" + std::to_string(count), parse);
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "dlist.h"
+#include "unrolled_dlist.h"
+
+#include <algorithm>
+#include <numeric>
+
+// Member search and reductions of unrolled_dlist, vectorized with the kernels
+// of simd.h, against the std algorithms over its iterators and over a dlist.
+// Configure with -DDLIST_AVX2=ON to build the AVX2 kernels instead of SSE2.
+
+template <typename T> void run(const std::string &type, size_t count)
+{
+    cxc::dlist<T> nodes{};
+    cxc::unrolled_dlist<T> chunks{};
+
+    for (size_t i = 0; i < count; i++)
+    {
+        nodes.insert_tail(static_cast<T>(i % 1000));
+        chunks.insert_tail(static_cast<T>(i % 1000));
+    }
+
+    // absent, so every search scans the whole list
+    T missing = static_cast<T>(-1);
+    std::string suffix = "<" + type + "> n=" + std::to_string(count);
+
+    auto report = [&](const std::string &name, auto &&fn) {
+        cxc::bench::report(name + suffix, cxc::bench::ns_per_op(count, fn));
+    };
+
+    report("std::find dlist", [&]() {
+        cxc::bench::keep(std::find(nodes.begin(), nodes.end(), missing) == nodes.end());
+    });
+    report("std::find unrolled", [&]() {
+        cxc::bench::keep(std::find(chunks.begin(), chunks.end(), missing) == chunks.end());
+    });
+    report("unrolled.find", [&]() { cxc::bench::keep(chunks.find(missing) == chunks.end()); });
+
+    report("std::count unrolled", [&]() { cxc::bench::keep(std::count(chunks.begin(), chunks.end(), T(7))); });
+    report("unrolled.count", [&]() { cxc::bench::keep(chunks.count(T(7))); });
+
+    report("std::accumulate unrolled", [&]() { cxc::bench::keep(std::accumulate(chunks.begin(), chunks.end(), T())); });
+    report("unrolled.sum", [&]() { cxc::bench::keep(chunks.sum()); });
+
+    report("std::min_element unrolled", [&]() { cxc::bench::keep(*std::min_element(chunks.begin(), chunks.end())); });
+    report("unrolled.min", [&]() { cxc::bench::keep(chunks.min()); });
+
+    report("std::find_if(< 0) unrolled", [&]() {
+        auto it = std::find_if(chunks.begin(), chunks.end(), [](const T &value) { return value < T(0); });
+        cxc::bench::keep(it == chunks.end());
+    });
+    report("unrolled.find_if(less_than)", [&]() {
+        cxc::bench::keep(chunks.find_if(cxc::less_than<T>{T(0)}) == chunks.end());
+    });
+}
+
+int main()
+{
+    std::cout << "kernels: " << cxc::simd::isa << std::endl;
+
+    size_t count = 1000000;
+
+    run<float>("float", count);
+    run<double>("double", count);
+    run<int>("int", count);
+    run<long>("long", count);
+}
@@ -0,0 +1,76 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <cstdlib>
+#include <list>
+#include <new>
+
+// Creating, filling and destroying many short lists, as when a list is a
+// local variable or a member of small objects: small_dlist against dlist with
+// its two allocators and std::list, with the heap allocations per list.
+
+static size_t allocations = 0;
+
+void *operator new(size_t size)
+{
+    allocations++;
+
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+template <typename List> void fill(List &list, int length)
+{
+    for (int i = 0; i < length; i++)
+        list.insert_tail(i);
+}
+
+template <typename T> void fill(std::list<T> &list, int length)
+{
+    for (int i = 0; i < length; i++)
+        list.push_back(i);
+}
+
+template <typename List> void run(const std::string &name, int length, size_t lists)
+{
+    auto body = [&]() {
+        for (size_t i = 0; i < lists; i++)
+        {
+            List list{};
+            fill(list, length);
+            cxc::bench::keep(list);
+        }
+    };
+
+    size_t before = allocations;
+    double ns = cxc::bench::ns_per_op(lists, body);
+    double per_list = static_cast<double>(allocations - before) / static_cast<double>(5 * lists);
+
+    cxc::bench::report(name + " len=" + std::to_string(length), ns);
+    std::cout << "    " << per_list << " heap allocations per list" << std::endl;
+}
+
+int main()
+{
+    size_t lists = 1000000;
+
+    for (int length : {4, 8, 16})
+    {
+        run<cxc::small_dlist<int, 8>>("small_dlist<8>", length, lists);
+        run<cxc::dlist<int>>("dlist node_pool", length, lists);
+        run<cxc::dlist<int, cxc::heap_allocator<int>>>("dlist heap", length, lists);
+        run<std::list<int>>("std::list", length, lists);
+    }
+}
@@ -0,0 +1,45 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Sorting a list of random ints in place, on several threads, and through a
+// std::vector round trip.
+//
+// usage: bench_sort [count]
+
+template <typename Fn> void run(const std::string &name, const std::vector<int> &values, Fn &&sort)
+{
+    cxc::dlist<int> list{};
+    list.append_range(values.begin(), values.end());
+
+    double ns = cxc::bench::ns_per_op(values.size(), [&]() { sort(list); }, 1);
+
+    cxc::bench::report(name + " n=" + std::to_string(values.size()), ns);
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    std::vector<int> values(count);
+    std::mt19937 rng(1);
+
+    for (int &value : values)
+        value = static_cast<int>(rng());
+
+    run("sort()", values, [](cxc::dlist<int> &list) { list.sort(); });
+
+    run("sort(cxc::par)", values, [](cxc::dlist<int> &list) { list.sort(cxc::par); });
+
+    run("vector copy + std::sort + reinsert", values, [](cxc::dlist<int> &list) {
+        std::vector<int> copy(list.begin(), list.end());
+        std::sort(copy.begin(), copy.end());
+
+        list.clear();
+        list.append_range(copy.begin(), copy.end());
+    });
+}
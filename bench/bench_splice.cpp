@@ -0,0 +1,58 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <vector>
+
+// Building a list from a vector with one insert per element against
+// append_range, and moving elements between lists with splice: relinked in
+// O(1) between lists sharing a node pool, moved node by node between lists
+// with their own default pools.
+
+int main()
+{
+    size_t count = 1000000;
+    std::vector<int> values(count, 7);
+
+    double inserts = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<int> list{};
+
+        for (int value : values)
+            list.insert(value);
+
+        cxc::bench::keep(list.size());
+    });
+
+    double range = cxc::bench::ns_per_op(count, [&]() {
+        cxc::dlist<int> list{};
+        list.append_range(values.begin(), values.end());
+
+        cxc::bench::keep(list.size());
+    });
+
+    cxc::dlist<int> source{};
+    cxc::dlist<int> target(std::allocator_arg, source.get_allocator());
+    source.append_range(values.begin(), values.end());
+
+    double shared = cxc::bench::ns_per_op(1000, [&]() {
+        for (int i = 0; i < 500; i++)
+        {
+            target.splice(target.begin(), source);
+            source.splice(source.end(), target);
+        }
+    });
+
+    cxc::dlist<int> own_source{};
+    cxc::dlist<int> own_target{};
+    own_source.append_range(values.begin(), values.end());
+
+    // each round trip moves every element twice, timed per element moved
+    double separate = cxc::bench::ns_per_op(2 * count, [&]() {
+        own_target.splice(own_target.begin(), own_source);
+        own_source.splice(own_source.end(), own_target);
+    });
+
+    cxc::bench::report("insert x n=" + std::to_string(count), inserts);
+    cxc::bench::report("append_range n=" + std::to_string(count), range);
+    cxc::bench::report("splice(whole list), shared pool n=" + std::to_string(count), shared);
+    cxc::bench::report("splice per element, separate pools n=" + std::to_string(count), separate);
+}
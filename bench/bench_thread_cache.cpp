@@ -0,0 +1,86 @@
+#include "bench.h"
+#include "dlist.h"
+#include "thread_cache.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads in a ring each build a list, hand it to the next thread and destroy
+// the list handed to them, so every node is freed by another thread than the
+// one that created it. Reports the wall time per node for 1 to 64 threads,
+// with nodes from the heap and from thread_cache_pool.
+
+template <typename List> double run(size_t threads, size_t rounds, size_t length)
+{
+    struct Mailbox
+    {
+        std::mutex lock;
+        List list{};
+    };
+
+    std::vector<Mailbox> mailboxes(threads);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]() {
+            Mailbox &next = mailboxes[(t + 1) % threads];
+            Mailbox &own = mailboxes[t];
+
+            for (size_t round = 0; round < rounds; round++)
+            {
+                List built{};
+
+                for (size_t i = 0; i < length; i++)
+                    built.insert_tail(static_cast<long>(i));
+
+                {
+                    std::lock_guard<std::mutex> guard(next.lock);
+                    next.list.splice(next.list.end(), built);
+                }
+
+                List received{};
+
+                {
+                    std::lock_guard<std::mutex> guard(own.lock);
+                    received.splice(received.end(), own.list);
+                }
+
+                cxc::bench::keep(received.size());
+            }
+        });
+    }
+
+    for (std::thread &worker : workers)
+        worker.join();
+
+    auto stop = std::chrono::steady_clock::now();
+
+    for (Mailbox &mailbox : mailboxes)
+        mailbox.list.clear();
+
+    double nodes = static_cast<double>(threads * rounds * length);
+    return std::chrono::duration<double, std::nano>(stop - start).count() / nodes;
+}
+
+int main()
+{
+    size_t rounds = 400;
+    size_t length = 512;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        std::string suffix = " threads=" + std::to_string(threads);
+
+        cxc::bench::report("heap_allocator" + suffix,
+                           run<cxc::dlist<long, cxc::heap_allocator<long>>>(threads, rounds, length));
+        cxc::bench::report("thread_cache_pool" + suffix,
+                           run<cxc::dlist<long, cxc::thread_cache_pool<long>>>(threads, rounds, length));
+    }
+}
@@ -0,0 +1,55 @@
+#include "bench.h"
+#include "dlist.h"
+#include "unrolled_dlist.h"
+
+#include <numeric>
+
+// Scan and middle-insertion cost of dlist<float> against unrolled_dlist<float>.
+
+template <typename List> void scan(const std::string &name, size_t count)
+{
+    List list{};
+
+    for (size_t i = 0; i < count; i++)
+        list.insert_tail(static_cast<float>(i));
+
+    double ns = cxc::bench::ns_per_op(count, [&list]() {
+        cxc::bench::keep(std::accumulate(list.begin(), list.end(), 0.0f));
+    });
+
+    cxc::bench::report(name + " scan n=" + std::to_string(count), ns);
+}
+
+template <typename List> void middle(const std::string &name, size_t count)
+{
+    size_t inserts = 1000;
+
+    double ns = cxc::bench::ns_per_op(
+        inserts,
+        [count, inserts]() {
+            List list{};
+
+            for (size_t i = 0; i < count; i++)
+                list.insert_tail(static_cast<float>(i));
+
+            for (size_t i = 0; i < inserts; i++)
+                list.insert_at(list.size() / 2, 1.0f);
+
+            cxc::bench::keep(list.size());
+        },
+        1);
+
+    cxc::bench::report(name + " insert_at(n/2) n=" + std::to_string(count), ns);
+}
+
+int main()
+{
+    for (size_t count : {10000, 1000000})
+    {
+        scan<cxc::dlist<float>>("dlist", count);
+        scan<cxc::unrolled_dlist<float>>("unrolled_dlist", count);
+    }
+
+    middle<cxc::dlist<float>>("dlist", 100000);
+    middle<cxc::unrolled_dlist<float>>("unrolled_dlist", 100000);
+}
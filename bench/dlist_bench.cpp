@@ -0,0 +1,517 @@
+#include "bench.h"
+#include "dlist.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <new>
+#include <string>
+#include <vector>
+
+// Microbenchmarks of every public dlist operation against std::list,
+// std::deque and std::vector, for several element types and sizes.
+//
+// Usage: dlist_bench [--json] [--min-size N] [--max-size N] [--runs N]
+//
+// Sizes are the powers of ten between --min-size (default 10) and --max-size
+// (default 10^6; 10^8 needs a few GB per container). Every measurement keeps
+// the fastest of --runs runs (default 3) and reports nanoseconds per
+// operation, heap allocations per operation and, for the container built by
+// insert_tail, live heap bytes per element (as requested from operator new,
+// without the malloc headers). The data is generated from a fixed
+// seed, so runs are comparable. --json prints one JSON array instead of a
+// table.
+
+// ----------------------------------------------------------------------------
+// allocation counting
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+size_t allocations = 0;
+size_t live_bytes = 0;
+
+// every block starts with a header recording its size, at least 16 bytes so
+// that the payload stays aligned for the default new
+constexpr size_t header_size = 16;
+
+void *counted_alloc(size_t size, size_t alignment)
+{
+    size_t header = std::max(header_size, alignment);
+    size_t total = (header + size + alignment - 1) / alignment * alignment;
+    char *base = static_cast<char *>(std::aligned_alloc(alignment, total));
+
+    if (base == nullptr)
+        throw std::bad_alloc();
+
+    char *memory = base + header;
+    std::memcpy(memory - sizeof(size_t), &size, sizeof(size_t));
+    std::memcpy(memory - 2 * sizeof(size_t), &header, sizeof(size_t));
+
+    allocations++;
+    live_bytes += size;
+
+    return memory;
+}
+
+void counted_free(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+
+    char *memory = static_cast<char *>(ptr);
+    size_t size;
+    size_t header;
+    std::memcpy(&size, memory - sizeof(size_t), sizeof(size_t));
+    std::memcpy(&header, memory - 2 * sizeof(size_t), sizeof(size_t));
+
+    live_bytes -= size;
+    std::free(memory - header);
+}
+
+} // namespace
+
+void *operator new(size_t size)
+{
+    return counted_alloc(size, alignof(std::max_align_t));
+}
+
+void *operator new[](size_t size)
+{
+    return counted_alloc(size, alignof(std::max_align_t));
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept
+{
+    counted_free(ptr);
+}
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// element types
+// ----------------------------------------------------------------------------
+
+struct payload64
+{
+    char bytes[64];
+
+    bool operator==(const payload64 &other) const
+    {
+        return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+};
+
+template <typename T> T make_value(uint64_t seed);
+
+template <> int make_value<int>(uint64_t seed)
+{
+    return static_cast<int>(seed);
+}
+
+template <> std::string make_value<std::string>(uint64_t seed)
+{
+    // longer than the small string buffer, so every copy allocates
+    return "element-" + std::to_string(seed) + "-of-the-benchmark";
+}
+
+template <> payload64 make_value<payload64>(uint64_t seed)
+{
+    payload64 value{};
+    std::memcpy(value.bytes, &seed, sizeof(seed));
+    return value;
+}
+
+template <typename T> const char *type_name();
+
+template <> const char *type_name<int>()
+{
+    return "int";
+}
+
+template <> const char *type_name<std::string>()
+{
+    return "string";
+}
+
+template <> const char *type_name<payload64>()
+{
+    return "payload64";
+}
+
+template <typename T> std::vector<T> make_values(size_t count)
+{
+    std::vector<T> values;
+    values.reserve(count);
+
+    uint64_t seed = 0x2545f4914f6cdd1dull;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        values.push_back(make_value<T>(seed % 1000003));
+    }
+
+    return values;
+}
+
+// ----------------------------------------------------------------------------
+// container adapters
+// ----------------------------------------------------------------------------
+
+template <typename T> struct is_dlist : std::false_type
+{
+};
+
+template <typename T, typename Alloc, typename Hooks, typename Index>
+struct is_dlist<cxc::dlist<T, Alloc, Hooks, Index>> : std::true_type
+{
+};
+
+template <typename C, typename T> void push_head(C &c, const T &value)
+{
+    if constexpr (is_dlist<C>::value)
+        c.insert_head(value);
+    else if constexpr (std::is_same_v<C, std::vector<T>>)
+        c.insert(c.begin(), value);
+    else
+        c.push_front(value);
+}
+
+template <typename C, typename T> void push_tail(C &c, const T &value)
+{
+    if constexpr (is_dlist<C>::value)
+        c.insert_tail(value);
+    else
+        c.push_back(value);
+}
+
+template <typename C, typename T> void insert_at(C &c, size_t position, const T &value)
+{
+    if constexpr (is_dlist<C>::value)
+        c.insert_at(position, value);
+    else
+        c.insert(std::next(c.begin(), static_cast<std::ptrdiff_t>(position)), value);
+}
+
+template <typename C> void remove_at(C &c, size_t position)
+{
+    if constexpr (is_dlist<C>::value)
+        c.remove_at(position);
+    else
+        c.erase(std::next(c.begin(), static_cast<std::ptrdiff_t>(position)));
+}
+
+template <typename C> auto &get_at(C &c, size_t position)
+{
+    if constexpr (is_dlist<C>::value)
+        return c.get_node(position)->data;
+    else
+        return *std::next(c.begin(), static_cast<std::ptrdiff_t>(position));
+}
+
+template <typename C, typename T> void change_at(C &c, size_t position, const T &value)
+{
+    if constexpr (is_dlist<C>::value)
+        c.change(position, value);
+    else
+        *std::next(c.begin(), static_cast<std::ptrdiff_t>(position)) = value;
+}
+
+template <typename C> void reverse(C &c)
+{
+    if constexpr (requires { c.reverse(); })
+        c.reverse();
+    else
+        std::reverse(c.begin(), c.end());
+}
+
+// ----------------------------------------------------------------------------
+// measurement
+// ----------------------------------------------------------------------------
+
+struct result
+{
+    std::string container;
+    std::string type;
+    std::string op;
+    size_t size;
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_element;
+};
+
+std::vector<result> results;
+int runs = 3;
+
+/**
+ * @brief Times body, which performs ops operations, after setup, keeping the
+ * fastest of the runs. Only the body is timed and counted.
+ */
+template <typename Setup, typename Body>
+void measure(const char *container, const char *type, const char *op, size_t size, size_t ops, Setup setup, Body body,
+             double bytes_per_element = -1)
+{
+    double best = 0;
+    size_t allocs = 0;
+
+    for (int r = 0; r < runs; r++)
+    {
+        auto state = setup();
+
+        size_t allocs_before = allocations;
+        auto start = std::chrono::steady_clock::now();
+        body(*state);
+        auto stop = std::chrono::steady_clock::now();
+        size_t allocs_after = allocations;
+
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(ops);
+
+        if (r == 0 || ns < best)
+        {
+            best = ns;
+            allocs = allocs_after - allocs_before;
+        }
+    }
+
+    results.push_back(result{container, type, op, size, best, static_cast<double>(allocs) / static_cast<double>(ops),
+                             bytes_per_element});
+}
+
+/**
+ * @brief Number of repetitions of an operation costing up to size steps, so
+ * that each measurement stays around 10^7 steps.
+ */
+size_t positional_ops(size_t size)
+{
+    return std::clamp<size_t>(10000000 / size, 1, std::max<size_t>(size / 2, 1));
+}
+
+template <typename C, typename T> void bench_container(const char *name, const std::vector<T> &values)
+{
+    const char *type = type_name<T>();
+    size_t size = values.size();
+    size_t middle = size / 2;
+    T probe = values[size - 1];
+
+    auto empty = []() { return std::make_unique<C>(); };
+
+    auto filled = [&values]() {
+        auto c = std::make_unique<C>();
+
+        for (const T &value : values)
+            push_tail(*c, value);
+
+        return c;
+    };
+
+    // live heap bytes of a container built by insert_tail, elements included
+    double bytes_per_element;
+    {
+        size_t before = live_bytes;
+        auto c = filled();
+        bytes_per_element = static_cast<double>(live_bytes - before) / static_cast<double>(size);
+    }
+
+    measure(name, type, "insert_tail", size, size, empty, [&values](C &c) {
+        for (const T &value : values)
+            push_tail(c, value);
+    }, bytes_per_element);
+
+    // front insertion into a vector is quadratic, keep it to the small sizes
+    if (!std::is_same_v<C, std::vector<T>> || size <= 100000)
+    {
+        measure(name, type, "insert_head", size, size, empty, [&values](C &c) {
+            for (const T &value : values)
+                push_head(c, value);
+        });
+    }
+
+    size_t ops = positional_ops(size);
+
+    measure(name, type, "insert_at", size, ops, filled, [&](C &c) {
+        for (size_t i = 0; i < ops; i++)
+            insert_at(c, middle, probe);
+    });
+
+    measure(name, type, "remove_at", size, ops, filled, [&](C &c) {
+        for (size_t i = 0; i < ops; i++)
+            remove_at(c, middle - i / 2);
+    });
+
+    measure(name, type, "get_node", size, ops, filled, [&](C &c) {
+        for (size_t i = 0; i < ops; i++)
+            cxc::bench::keep(get_at(c, middle));
+    });
+
+    measure(name, type, "change", size, ops, filled, [&](C &c) {
+        for (size_t i = 0; i < ops; i++)
+            change_at(c, middle, probe);
+    });
+
+    measure(name, type, "reverse", size, size, filled, [](C &c) { reverse(c); });
+
+    measure(name, type, "iterate", size, size, filled, [](C &c) {
+        size_t count = 0;
+
+        for (auto &value : c)
+        {
+            cxc::bench::keep(value);
+            count++;
+        }
+
+        cxc::bench::keep(count);
+    });
+
+    measure(name, type, "std::find", size, size, filled,
+            [&probe](C &c) { cxc::bench::keep(std::find(c.begin(), c.end(), probe)); });
+}
+
+template <typename T> void bench_type(size_t size)
+{
+    std::vector<T> values = make_values<T>(size);
+
+    bench_container<cxc::dlist<T>>("dlist", values);
+    bench_container<cxc::dlist<T, cxc::heap_allocator<T>>>("dlist<heap_allocator>", values);
+    bench_container<std::list<T>>("std::list", values);
+    bench_container<std::deque<T>>("std::deque", values);
+    bench_container<std::vector<T>>("std::vector", values);
+}
+
+void print_table()
+{
+    std::cout << std::left << std::setw(24) << "container" << std::setw(11) << "type" << std::setw(13) << "op"
+              << std::right << std::setw(11) << "n" << std::setw(14) << "ns/op" << std::setw(12) << "allocs/op"
+              << std::setw(12) << "bytes/elem" << std::endl;
+
+    for (const result &r : results)
+    {
+        std::cout << std::left << std::setw(24) << r.container << std::setw(11) << r.type << std::setw(13) << r.op
+                  << std::right << std::setw(11) << r.size << std::fixed << std::setprecision(2) << std::setw(14)
+                  << r.ns_per_op << std::setw(12) << r.allocs_per_op << std::setw(12);
+
+        if (r.bytes_per_element >= 0)
+            std::cout << r.bytes_per_element;
+        else
+            std::cout << "-";
+
+        std::cout << std::endl;
+    }
+}
+
+void print_json()
+{
+    std::cout << "[" << std::endl;
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const result &r = results[i];
+
+        std::cout << "  {\"container\": \"" << r.container << "\", \"type\": \"" << r.type << "\", \"op\": \""
+                  << r.op << "\", \"n\": " << r.size << ", \"ns_per_op\": " << r.ns_per_op
+                  << ", \"allocs_per_op\": " << r.allocs_per_op << ", \"bytes_per_element\": ";
+
+        if (r.bytes_per_element >= 0)
+            std::cout << r.bytes_per_element;
+        else
+            std::cout << "null";
+
+        std::cout << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    std::cout << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool json = false;
+    size_t min_size = 10;
+    size_t max_size = 1000000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--json")
+            json = true;
+        else if (arg == "--min-size" && i + 1 < argc)
+            min_size = std::stoull(argv[++i]);
+        else if (arg == "--max-size" && i + 1 < argc)
+            max_size = std::stoull(argv[++i]);
+        else if (arg == "--runs" && i + 1 < argc)
+            runs = std::max(1, std::stoi(argv[++i]));
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--json] [--min-size N] [--max-size N] [--runs N]" << std::endl;
+            return 1;
+        }
+    }
+
+    for (size_t size = std::max<size_t>(min_size, 2); size <= max_size; size *= 10)
+    {
+        bench_type<int>(size);
+        bench_type<std::string>(size);
+        bench_type<payload64>(size);
+    }
+
+    if (json)
+        print_json();
+    else
+        print_table();
+}
@@ -0,0 +1,607 @@
+#ifndef CXC_CACHE_TPP
+#define CXC_CACHE_TPP
+
+#include "cache.h"
+
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Constructor for the lru_cache struct.
+ *
+ * @param capacity The largest total weight of the entries.
+ * @param weigher Returns the weight of an entry from its key and value.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+lru_cache<K, V, Weigher, Hash, KeyEqual>::lru_cache(size_t capacity, Weigher weigher)
+    : m_capacity(capacity), m_weigher(std::move(weigher))
+{
+}
+
+/**
+ * @brief Removes an entry without calling the eviction callback.
+ *
+ * @param node The node of the entry.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Weigher, Hash, KeyEqual>::remove(Node<entry_type> *node)
+{
+    m_weight -= node->data.weight;
+    m_map.erase(node->data.key);
+    m_entries.erase(typename dlist<entry_type>::Iterator(node));
+}
+
+/**
+ * @brief Evicts the least recently used entries until the given weight fits.
+ *
+ * @param room The weight to make room for.
+ * @param keep An entry that must not be evicted, nullptr for none.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Weigher, Hash, KeyEqual>::shrink(size_t room, Node<entry_type> *keep)
+{
+    while (!m_entries.is_empty() && m_weight + room > m_capacity)
+    {
+        if (m_entries.get_node(m_entries.size() - 1) == keep || !evict())
+            return;
+    }
+}
+
+/**
+ * @brief Looks up a key and marks its entry as the most recently used.
+ *
+ * @param key The key to look up.
+ * @return Pointer to the value, nullptr if the key is not cached.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+V *lru_cache<K, V, Weigher, Hash, KeyEqual>::get(const K &key)
+{
+    auto found = m_map.find(key);
+
+    if (found == m_map.end())
+        return nullptr;
+
+    Node<entry_type> *node = found->second;
+    m_entries.splice(m_entries.begin(), m_entries, typename dlist<entry_type>::Iterator(node));
+
+    return &node->data.value;
+}
+
+/**
+ * @brief Looks up a key without changing the eviction order.
+ *
+ * @param key The key to look up.
+ * @return Pointer to the value, nullptr if the key is not cached.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+V *lru_cache<K, V, Weigher, Hash, KeyEqual>::peek(const K &key)
+{
+    auto found = m_map.find(key);
+    return found != m_map.end() ? &found->second->data.value : nullptr;
+}
+
+/**
+ * @brief Checks if a key is cached, without changing the eviction order.
+ *
+ * @param key The key to look up.
+ * @return true if the key is cached, false otherwise.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Weigher, Hash, KeyEqual>::contains(const K &key)
+{
+    return m_map.find(key) != m_map.end();
+}
+
+/**
+ * @brief Caches a value as the most recently used entry, replacing the value
+ * of a cached key, and evicts entries until the weights fit the capacity.
+ *
+ * @param key The key.
+ * @param value The value.
+ * @return true if the value was cached, false if it alone outweighs the
+ * capacity, in which case the key is no longer cached.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Weigher, Hash, KeyEqual>::put(K key, V value)
+{
+    size_t weight = m_weigher(key, value);
+    auto found = m_map.find(key);
+
+    if (weight > m_capacity)
+    {
+        if (found != m_map.end())
+            remove(found->second);
+
+        return false;
+    }
+
+    if (found != m_map.end())
+    {
+        Node<entry_type> *node = found->second;
+
+        m_weight = m_weight - node->data.weight + weight;
+        node->data.value = std::move(value);
+        node->data.weight = weight;
+
+        m_entries.splice(m_entries.begin(), m_entries, typename dlist<entry_type>::Iterator(node));
+        shrink(0, node);
+
+        return true;
+    }
+
+    shrink(weight);
+
+    m_entries.emplace_head(entry_type{std::move(key), std::move(value), weight, 1});
+    Node<entry_type> *node = m_entries.begin().get_addr();
+
+    try
+    {
+        m_map.emplace(node->data.key, node);
+    }
+    catch (...)
+    {
+        m_entries.remove_head();
+        throw;
+    }
+
+    m_weight += weight;
+    return true;
+}
+
+/**
+ * @brief Removes a key, without calling the eviction callback.
+ *
+ * @param key The key to remove.
+ * @return true if the key was cached, false otherwise.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Weigher, Hash, KeyEqual>::erase(const K &key)
+{
+    auto found = m_map.find(key);
+
+    if (found == m_map.end())
+        return false;
+
+    remove(found->second);
+    return true;
+}
+
+/**
+ * @brief Evicts the least recently used entry, calling the eviction
+ * callback.
+ *
+ * @return true if an entry was evicted, false if the cache is empty.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lru_cache<K, V, Weigher, Hash, KeyEqual>::evict()
+{
+    if (m_entries.is_empty())
+        return false;
+
+    Node<entry_type> *node = m_entries.get_node(m_entries.size() - 1);
+
+    if (m_on_evict)
+        m_on_evict(node->data.key, node->data.value);
+
+    remove(node);
+    return true;
+}
+
+/**
+ * @brief Removes every entry, without calling the eviction callback.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Weigher, Hash, KeyEqual>::clear()
+{
+    m_map.clear();
+    m_entries.clear();
+    m_weight = 0;
+}
+
+/**
+ * @brief Changes the capacity, evicting entries until they fit.
+ *
+ * @param capacity The new capacity.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Weigher, Hash, KeyEqual>::set_capacity(size_t capacity)
+{
+    m_capacity = capacity;
+    shrink(0);
+}
+
+/**
+ * @brief Sets the function called with the key and value of every evicted
+ * entry.
+ *
+ * @param callback The callback, an empty function for none.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lru_cache<K, V, Weigher, Hash, KeyEqual>::set_eviction_callback(eviction_callback callback)
+{
+    m_on_evict = std::move(callback);
+}
+
+/**
+ * @brief Returns the number of cached entries.
+ *
+ * @return The number of entries.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+size_t lru_cache<K, V, Weigher, Hash, KeyEqual>::size()
+{
+    return m_map.size();
+}
+
+/**
+ * @brief Returns the total weight of the cached entries.
+ *
+ * @return The total weight.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+size_t lru_cache<K, V, Weigher, Hash, KeyEqual>::weight()
+{
+    return m_weight;
+}
+
+/**
+ * @brief Returns the largest total weight of the entries.
+ *
+ * @return The capacity.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+size_t lru_cache<K, V, Weigher, Hash, KeyEqual>::capacity()
+{
+    return m_capacity;
+}
+
+/**
+ * @brief Constructor for the lfu_cache struct.
+ *
+ * @param capacity The largest total weight of the entries.
+ * @param weigher Returns the weight of an entry from its key and value.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+lfu_cache<K, V, Weigher, Hash, KeyEqual>::lfu_cache(size_t capacity, Weigher weigher)
+    : m_capacity(capacity), m_weigher(std::move(weigher))
+{
+}
+
+/**
+ * @brief Deletes an empty bucket and its access count.
+ *
+ * @param bucket The bucket.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::drop(bucket_iterator bucket)
+{
+    m_frequencies.erase(dlist<size_t>::Iterator(bucket->second.order));
+    m_buckets.erase(bucket);
+}
+
+/**
+ * @brief Counts an access to an entry: moves it to the front of the next
+ * count's bucket, creating that bucket after the current one if needed.
+ *
+ * @param node The node of the entry.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::promote(Node<entry_type> *node)
+{
+    size_t frequency = node->data.frequency;
+    // a reference, since creating the next bucket may rehash and invalidate
+    // iterators into m_buckets
+    Bucket &from = m_buckets.find(frequency)->second;
+    bucket_iterator to = m_buckets.find(frequency + 1);
+
+    if (to == m_buckets.end())
+    {
+        to = m_buckets.try_emplace(frequency + 1, m_pool).first;
+        to->second.order =
+            m_frequencies.insert_after(dlist<size_t>::Iterator(from.order), frequency + 1).get_addr();
+    }
+
+    dlist<entry_type> &entries = to->second.entries;
+    entries.splice(entries.begin(), from.entries, typename dlist<entry_type>::Iterator(node));
+    node->data.frequency++;
+
+    if (from.entries.is_empty())
+        drop(m_buckets.find(frequency));
+}
+
+/**
+ * @brief Removes an entry without calling the eviction callback.
+ *
+ * @param node The node of the entry.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::remove(Node<entry_type> *node)
+{
+    bucket_iterator bucket = m_buckets.find(node->data.frequency);
+
+    m_weight -= node->data.weight;
+    m_map.erase(node->data.key);
+    bucket->second.entries.erase(typename dlist<entry_type>::Iterator(node));
+
+    if (bucket->second.entries.is_empty())
+        drop(bucket);
+}
+
+/**
+ * @brief Returns the entry to evict next: the least recently used one of the
+ * lowest count, or of the next count if that one is the kept entry.
+ *
+ * @param keep An entry that must not be evicted, nullptr for none.
+ * @return The node of the entry, nullptr if there is none to evict.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+Node<cache_entry<K, V>> *lfu_cache<K, V, Weigher, Hash, KeyEqual>::victim(Node<entry_type> *keep)
+{
+    // the kept entry was just promoted to the front of its bucket, so when
+    // it is last it is alone and the next bucket has another candidate
+    for (size_t frequency : m_frequencies)
+    {
+        dlist<entry_type> &entries = m_buckets.find(frequency)->second.entries;
+        Node<entry_type> *last = entries.get_node(entries.size() - 1);
+
+        if (last != keep)
+            return last;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Evicts entries until the given weight fits.
+ *
+ * @param room The weight to make room for.
+ * @param keep An entry that must not be evicted, nullptr for none.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::shrink(size_t room, Node<entry_type> *keep)
+{
+    while (m_weight + room > m_capacity)
+    {
+        Node<entry_type> *node = victim(keep);
+
+        if (node == nullptr)
+            return;
+
+        if (m_on_evict)
+            m_on_evict(node->data.key, node->data.value);
+
+        remove(node);
+    }
+}
+
+/**
+ * @brief Looks up a key and counts an access to its entry.
+ *
+ * @param key The key to look up.
+ * @return Pointer to the value, nullptr if the key is not cached.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+V *lfu_cache<K, V, Weigher, Hash, KeyEqual>::get(const K &key)
+{
+    auto found = m_map.find(key);
+
+    if (found == m_map.end())
+        return nullptr;
+
+    Node<entry_type> *node = found->second;
+    promote(node);
+
+    return &node->data.value;
+}
+
+/**
+ * @brief Looks up a key without counting an access.
+ *
+ * @param key The key to look up.
+ * @return Pointer to the value, nullptr if the key is not cached.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+V *lfu_cache<K, V, Weigher, Hash, KeyEqual>::peek(const K &key)
+{
+    auto found = m_map.find(key);
+    return found != m_map.end() ? &found->second->data.value : nullptr;
+}
+
+/**
+ * @brief Checks if a key is cached, without counting an access.
+ *
+ * @param key The key to look up.
+ * @return true if the key is cached, false otherwise.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lfu_cache<K, V, Weigher, Hash, KeyEqual>::contains(const K &key)
+{
+    return m_map.find(key) != m_map.end();
+}
+
+/**
+ * @brief Caches a value, replacing the value of a cached key and counting an
+ * access to it, and evicts entries until the weights fit the capacity. A new
+ * entry starts with one access.
+ *
+ * @param key The key.
+ * @param value The value.
+ * @return true if the value was cached, false if it alone outweighs the
+ * capacity, in which case the key is no longer cached.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lfu_cache<K, V, Weigher, Hash, KeyEqual>::put(K key, V value)
+{
+    size_t weight = m_weigher(key, value);
+    auto found = m_map.find(key);
+
+    if (weight > m_capacity)
+    {
+        if (found != m_map.end())
+            remove(found->second);
+
+        return false;
+    }
+
+    if (found != m_map.end())
+    {
+        Node<entry_type> *node = found->second;
+
+        m_weight = m_weight - node->data.weight + weight;
+        node->data.value = std::move(value);
+        node->data.weight = weight;
+
+        promote(node);
+        shrink(0, node);
+
+        return true;
+    }
+
+    shrink(weight);
+
+    bucket_iterator bucket = m_buckets.find(1);
+
+    if (bucket == m_buckets.end())
+    {
+        bucket = m_buckets.try_emplace(1, m_pool).first;
+
+        // 1 is the lowest count there can be
+        m_frequencies.insert_head(1);
+        bucket->second.order = m_frequencies.begin().get_addr();
+    }
+
+    dlist<entry_type> &entries = bucket->second.entries;
+    entries.emplace_head(entry_type{std::move(key), std::move(value), weight, 1});
+    Node<entry_type> *node = entries.begin().get_addr();
+
+    try
+    {
+        m_map.emplace(node->data.key, node);
+    }
+    catch (...)
+    {
+        entries.remove_head();
+
+        if (entries.is_empty())
+            drop(bucket);
+
+        throw;
+    }
+
+    m_weight += weight;
+    return true;
+}
+
+/**
+ * @brief Removes a key, without calling the eviction callback.
+ *
+ * @param key The key to remove.
+ * @return true if the key was cached, false otherwise.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lfu_cache<K, V, Weigher, Hash, KeyEqual>::erase(const K &key)
+{
+    auto found = m_map.find(key);
+
+    if (found == m_map.end())
+        return false;
+
+    remove(found->second);
+    return true;
+}
+
+/**
+ * @brief Evicts the least recently used entry of the lowest access count,
+ * calling the eviction callback.
+ *
+ * @return true if an entry was evicted, false if the cache is empty.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+bool lfu_cache<K, V, Weigher, Hash, KeyEqual>::evict()
+{
+    Node<entry_type> *node = victim(nullptr);
+
+    if (node == nullptr)
+        return false;
+
+    if (m_on_evict)
+        m_on_evict(node->data.key, node->data.value);
+
+    remove(node);
+    return true;
+}
+
+/**
+ * @brief Removes every entry, without calling the eviction callback.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::clear()
+{
+    m_map.clear();
+    m_buckets.clear();
+    m_frequencies.clear();
+    m_weight = 0;
+}
+
+/**
+ * @brief Changes the capacity, evicting entries until they fit.
+ *
+ * @param capacity The new capacity.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::set_capacity(size_t capacity)
+{
+    m_capacity = capacity;
+    shrink(0);
+}
+
+/**
+ * @brief Sets the function called with the key and value of every evicted
+ * entry.
+ *
+ * @param callback The callback, an empty function for none.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+void lfu_cache<K, V, Weigher, Hash, KeyEqual>::set_eviction_callback(eviction_callback callback)
+{
+    m_on_evict = std::move(callback);
+}
+
+/**
+ * @brief Returns the number of cached entries.
+ *
+ * @return The number of entries.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+size_t lfu_cache<K, V, Weigher, Hash, KeyEqual>::size()
+{
+    return m_map.size();
+}
+
+/**
+ * @brief Returns the total weight of the cached entries.
+ *
+ * @return The total weight.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+size_t lfu_cache<K, V, Weigher, Hash, KeyEqual>::weight()
+{
+    return m_weight;
+}
+
+/**
+ * @brief Returns the largest total weight of the entries.
+ *
+ * @return The capacity.
+ */
+template <typename K, typename V, typename Weigher, typename Hash, typename KeyEqual>
+size_t lfu_cache<K, V, Weigher, Hash, KeyEqual>::capacity()
+{
+    return m_capacity;
+}
+
+} // namespace cxc
+
+#endif
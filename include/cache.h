@@ -0,0 +1,184 @@
+#ifndef CXC_CACHE_H
+#define CXC_CACHE_H
+
+#include "dlist.h"
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+namespace cxc
+{
+
+/**
+ * @brief Default cache weigher: every entry weighs 1, so the capacity is a
+ * number of entries.
+ *
+ * A weigher returning the bytes an entry holds, for instance
+ * [](const K &, const std::string &v) { return sizeof(K) + v.size(); },
+ * turns the capacity into a number of bytes.
+ */
+struct unit_weight
+{
+    template <typename K, typename V> size_t operator()(const K &, const V &) const
+    {
+        return 1;
+    }
+};
+
+/**
+ * @brief Entry of an lru_cache or lfu_cache.
+ */
+template <typename K, typename V> struct cache_entry
+{
+    K key;
+    V value;
+    size_t weight;
+    // number of accesses, used by lfu_cache
+    size_t frequency;
+};
+
+/**
+ * @brief Least recently used cache with O(1) get, put and eviction.
+ *
+ * Entries live in a dlist ordered from the most to the least recently used,
+ * and a hash map leads from each key to its node: a hit splices the node to
+ * the front and an eviction removes the tail, without walking the list.
+ *
+ * The total weight of the entries is kept within the capacity by evicting
+ * the least recently used ones before a put. The eviction callback is called
+ * for each of them, and must not modify the cache. Pointers returned by get
+ * stay valid until the entry is erased or evicted.
+ *
+ * @tparam K The type of the keys.
+ * @tparam V The type of the values.
+ * @tparam Weigher Returns the weight of an entry from its key and value.
+ * @tparam Hash The hash of the keys.
+ * @tparam KeyEqual The equality of the keys.
+ */
+template <typename K, typename V, typename Weigher = unit_weight, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+struct lru_cache
+{
+    using entry_type = cache_entry<K, V>;
+    using eviction_callback = std::function<void(const K &, V &)>;
+
+  private:
+    dlist<entry_type> m_entries{};
+    std::unordered_map<K, Node<entry_type> *, Hash, KeyEqual> m_map;
+    size_t m_capacity;
+    size_t m_weight = 0;
+    Weigher m_weigher;
+    eviction_callback m_on_evict;
+
+    void remove(Node<entry_type> *node);
+
+    void shrink(size_t room, Node<entry_type> *keep = nullptr);
+
+  public:
+    explicit lru_cache(size_t capacity, Weigher weigher = Weigher{});
+    lru_cache(const lru_cache &) = delete;
+    lru_cache &operator=(const lru_cache &) = delete;
+
+    V *get(const K &key);
+    V *peek(const K &key);
+    bool contains(const K &key);
+    bool put(K key, V value);
+    bool erase(const K &key);
+    bool evict();
+    void clear();
+
+    void set_capacity(size_t capacity);
+    void set_eviction_callback(eviction_callback callback);
+
+    size_t size();
+    size_t weight();
+    size_t capacity();
+};
+
+/**
+ * @brief Least frequently used cache with O(1) get, put and eviction.
+ *
+ * Entries are grouped in one dlist per access count, all sharing one node
+ * pool, so a hit splices the node from its count's list to the next one in
+ * O(1). The lowest count in use is tracked, and an eviction removes the
+ * least recently used entry of that count. A key that is put again keeps
+ * its count.
+ *
+ * Capacity, weights, eviction callback and pointer validity are as for
+ * lru_cache.
+ *
+ * @tparam K The type of the keys.
+ * @tparam V The type of the values.
+ * @tparam Weigher Returns the weight of an entry from its key and value.
+ * @tparam Hash The hash of the keys.
+ * @tparam KeyEqual The equality of the keys.
+ */
+template <typename K, typename V, typename Weigher = unit_weight, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+struct lfu_cache
+{
+    using entry_type = cache_entry<K, V>;
+    using eviction_callback = std::function<void(const K &, V &)>;
+
+  private:
+    // the entries of one access count, from the most to the least recent
+    struct Bucket
+    {
+        dlist<entry_type> entries;
+        // node of the count in m_frequencies
+        Node<size_t> *order = nullptr;
+
+        explicit Bucket(node_pool<entry_type> &pool) : entries(std::allocator_arg, pool)
+        {
+        }
+    };
+
+    using bucket_iterator = typename std::unordered_map<size_t, Bucket>::iterator;
+
+    node_pool<entry_type> m_pool{};
+    std::unordered_map<size_t, Bucket> m_buckets;
+    // the access counts in use, in increasing order
+    dlist<size_t> m_frequencies{};
+    std::unordered_map<K, Node<entry_type> *, Hash, KeyEqual> m_map;
+    size_t m_capacity;
+    size_t m_weight = 0;
+    Weigher m_weigher;
+    eviction_callback m_on_evict;
+
+    void drop(bucket_iterator bucket);
+
+    void promote(Node<entry_type> *node);
+
+    void remove(Node<entry_type> *node);
+
+    Node<entry_type> *victim(Node<entry_type> *keep);
+
+    void shrink(size_t room, Node<entry_type> *keep = nullptr);
+
+  public:
+    explicit lfu_cache(size_t capacity, Weigher weigher = Weigher{});
+    lfu_cache(const lfu_cache &) = delete;
+    lfu_cache &operator=(const lfu_cache &) = delete;
+
+    V *get(const K &key);
+    V *peek(const K &key);
+    bool contains(const K &key);
+    bool put(K key, V value);
+    bool erase(const K &key);
+    bool evict();
+    void clear();
+
+    void set_capacity(size_t capacity);
+    void set_eviction_callback(eviction_callback callback);
+
+    size_t size();
+    size_t weight();
+    size_t capacity();
+};
+
+} // namespace cxc
+
+#include "cache.cpp"
+
+#endif
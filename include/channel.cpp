@@ -0,0 +1,305 @@
+#ifndef CXC_CHANNEL_TPP
+#define CXC_CHANNEL_TPP
+
+#include "channel.h"
+
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Constructor for an empty, open channel.
+ *
+ * @tparam T The type of the elements.
+ * @param capacity The number of elements buffered before push() suspends.
+ */
+template <typename T> channel<T>::channel(size_t capacity) : m_capacity(capacity)
+{
+}
+
+/**
+ * @brief Takes the next element for a consumer, refilling the buffer from
+ * the first waiting producer. The caller holds the lock.
+ *
+ * @param value Receives the element, left empty if the channel is closed and
+ * drained.
+ * @param wake Receives the producer to resume once the lock is released.
+ * @return true if the consumer is served, false if it has to wait.
+ */
+template <typename T> bool channel<T>::take(std::optional<T> &value, std::coroutine_handle<> &wake)
+{
+    if (!buffer.is_empty())
+    {
+        value.emplace(std::move(*buffer.begin()));
+        buffer.remove_head();
+
+        if (!producers.is_empty())
+        {
+            push_awaiter &producer = producers.get_head();
+            producers.remove_head();
+
+            buffer.insert_tail(std::move(producer.value));
+            producer.accepted = true;
+            wake = producer.handle;
+        }
+
+        return true;
+    }
+
+    // without buffer, producers wait with their element until a consumer comes
+    if (!producers.is_empty())
+    {
+        push_awaiter &producer = producers.get_head();
+        producers.remove_head();
+
+        value.emplace(std::move(producer.value));
+        producer.accepted = true;
+        wake = producer.handle;
+
+        return true;
+    }
+
+    return closed;
+}
+
+/**
+ * @brief Hands an element to the first waiting consumer, or buffers it if
+ * there is room. The caller holds the lock and has checked that the channel
+ * is open.
+ *
+ * @param value The element, moved from if it is taken.
+ * @param wake Receives the consumer to resume once the lock is released.
+ * @return true if the element was taken, false if the producer has to wait.
+ */
+template <typename T> bool channel<T>::offer(T &value, std::coroutine_handle<> &wake)
+{
+    if (!consumers.is_empty())
+    {
+        pop_awaiter &consumer = consumers.get_head();
+        consumers.remove_head();
+
+        consumer.value.emplace(std::move(value));
+        wake = consumer.handle;
+
+        return true;
+    }
+
+    if (buffer.size() < m_capacity)
+    {
+        buffer.insert_tail(std::move(value));
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Takes an element if one is ready, otherwise suspends the caller
+ * until a push or close() resumes it.
+ *
+ * @param caller The awaiting coroutine.
+ * @return true if the caller is suspended, false if it goes on at once.
+ */
+template <typename T> bool channel<T>::pop_awaiter::await_suspend(std::coroutine_handle<> caller)
+{
+    std::coroutine_handle<> wake;
+
+    {
+        std::lock_guard<std::mutex> guard(ch.lock);
+
+        if (!ch.take(value, wake))
+        {
+            // from here on another thread may resume the caller
+            handle = caller;
+            ch.consumers.insert_tail(*this);
+            return true;
+        }
+    }
+
+    if (wake)
+        wake.resume();
+
+    return false;
+}
+
+/**
+ * @brief Delivers the element if a consumer or room is there, otherwise
+ * suspends the caller until a pop or close() resumes it.
+ *
+ * @param caller The awaiting coroutine.
+ * @return true if the caller is suspended, false if it goes on at once.
+ */
+template <typename T> bool channel<T>::push_awaiter::await_suspend(std::coroutine_handle<> caller)
+{
+    std::coroutine_handle<> wake;
+
+    {
+        std::lock_guard<std::mutex> guard(ch.lock);
+
+        if (!ch.closed && !ch.offer(value, wake))
+        {
+            handle = caller;
+            ch.producers.insert_tail(*this);
+            return true;
+        }
+
+        accepted = !ch.closed;
+    }
+
+    if (wake)
+        wake.resume();
+
+    return false;
+}
+
+/**
+ * @brief Returns an awaitable taking the next element.
+ *
+ * @return The awaiter, giving the element, or std::nullopt once the channel
+ * is closed and drained.
+ */
+template <typename T> typename channel<T>::pop_awaiter channel<T>::pop()
+{
+    return pop_awaiter(*this);
+}
+
+/**
+ * @brief Returns an awaitable delivering an element, suspending while the
+ * channel is full.
+ *
+ * @param value The element.
+ * @return The awaiter, giving true if the element was delivered, false if
+ * the channel was closed.
+ */
+template <typename T> typename channel<T>::push_awaiter channel<T>::push(T value)
+{
+    return push_awaiter(*this, std::move(value));
+}
+
+/**
+ * @brief Takes an element without suspending.
+ *
+ * @return The element, or std::nullopt if none is ready.
+ */
+template <typename T> std::optional<T> channel<T>::try_pop()
+{
+    std::optional<T> value;
+    std::coroutine_handle<> wake;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        take(value, wake);
+    }
+
+    if (wake)
+        wake.resume();
+
+    return value;
+}
+
+/**
+ * @brief Delivers an element without suspending, resuming a waiting consumer
+ * if there is one.
+ *
+ * @param value The element.
+ * @return true if the element was delivered, false if the channel is full or
+ * closed.
+ */
+template <typename T> bool channel<T>::try_push(T value)
+{
+    std::coroutine_handle<> wake;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        if (closed || !offer(value, wake))
+            return false;
+    }
+
+    if (wake)
+        wake.resume();
+
+    return true;
+}
+
+/**
+ * @brief Closes the channel: waiting consumers get std::nullopt and waiting
+ * producers false, later pushes fail, and buffered elements can still be
+ * popped.
+ */
+template <typename T> void channel<T>::close()
+{
+    intrusive_dlist<pop_awaiter> waiting_consumers;
+    intrusive_dlist<push_awaiter> waiting_producers;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+
+        while (!consumers.is_empty())
+        {
+            pop_awaiter &consumer = consumers.get_head();
+            consumers.remove_head();
+            waiting_consumers.insert_tail(consumer);
+        }
+
+        while (!producers.is_empty())
+        {
+            push_awaiter &producer = producers.get_head();
+            producers.remove_head();
+            waiting_producers.insert_tail(producer);
+        }
+    }
+
+    // unlinked before resuming, as a resumed coroutine may free its awaiter
+    while (!waiting_consumers.is_empty())
+    {
+        pop_awaiter &consumer = waiting_consumers.get_head();
+        waiting_consumers.remove_head();
+        consumer.handle.resume();
+    }
+
+    while (!waiting_producers.is_empty())
+    {
+        push_awaiter &producer = waiting_producers.get_head();
+        waiting_producers.remove_head();
+        producer.handle.resume();
+    }
+}
+
+/**
+ * @brief Checks if the channel was closed.
+ *
+ * @return true if close() was called, false otherwise.
+ */
+template <typename T> bool channel<T>::is_closed()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return closed;
+}
+
+/**
+ * @brief Returns the number of buffered elements at the time of the call.
+ *
+ * @return The number of buffered elements.
+ */
+template <typename T> size_t channel<T>::size()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return buffer.size();
+}
+
+/**
+ * @brief Returns the number of elements the channel buffers.
+ *
+ * @return The capacity.
+ */
+template <typename T> size_t channel<T>::capacity()
+{
+    return m_capacity;
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef CXC_CHANNEL_H
+#define CXC_CHANNEL_H
+
+#include "dlist.h"
+#include "intrusive_dlist.h"
+
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace cxc
+{
+
+/**
+ * @brief Bounded channel between coroutines.
+ *
+ * `co_await ch.pop()` suspends until an element arrives and gives it as a
+ * std::optional, empty once the channel is closed and drained.
+ * `co_await ch.push(value)` suspends while the channel is full, and gives
+ * false if the channel was closed. try_push() and try_pop() never suspend,
+ * for code outside coroutines.
+ *
+ * Buffered elements live in a dlist, whose node pool recycles their nodes.
+ * Suspended coroutines wait in intrusive lists of their awaiters, so waiting
+ * allocates nothing. A push with a consumer waiting hands the element to it
+ * and resumes it right away on the pushing thread, without going through a
+ * scheduler; likewise a pop resumes a producer waiting for room. A capacity
+ * of 0 makes every push wait for a consumer.
+ *
+ * All members are thread-safe. Coroutines are resumed on the thread of the
+ * operation that wakes them, after the channel's lock is released. The
+ * channel must outlive its suspended coroutines.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T> struct channel
+{
+    struct pop_awaiter;
+    struct push_awaiter;
+
+  private:
+    std::mutex lock;
+    dlist<T> buffer{};
+    size_t m_capacity;
+    bool closed = false;
+    intrusive_dlist<pop_awaiter> consumers;
+    intrusive_dlist<push_awaiter> producers;
+
+    bool take(std::optional<T> &value, std::coroutine_handle<> &wake);
+
+    bool offer(T &value, std::coroutine_handle<> &wake);
+
+  public:
+    /**
+     * @brief Awaiter of pop(), waiting in the channel while suspended.
+     */
+    struct pop_awaiter : dlist_hook<>
+    {
+      private:
+        channel &ch;
+        std::optional<T> value{};
+        std::coroutine_handle<> handle{};
+
+        friend struct channel;
+
+      public:
+        explicit pop_awaiter(channel &c) : ch(c)
+        {
+        }
+
+        bool await_ready()
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> caller);
+
+        std::optional<T> await_resume()
+        {
+            return std::move(value);
+        }
+    };
+
+    /**
+     * @brief Awaiter of push(), holding the element while suspended.
+     */
+    struct push_awaiter : dlist_hook<>
+    {
+      private:
+        channel &ch;
+        T value;
+        bool accepted = false;
+        std::coroutine_handle<> handle{};
+
+        friend struct channel;
+
+      public:
+        push_awaiter(channel &c, T v) : ch(c), value(std::move(v))
+        {
+        }
+
+        bool await_ready()
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> caller);
+
+        bool await_resume()
+        {
+            return accepted;
+        }
+    };
+
+    explicit channel(size_t capacity);
+    channel(const channel &) = delete;
+    channel &operator=(const channel &) = delete;
+
+    pop_awaiter pop();
+    push_awaiter push(T value);
+
+    std::optional<T> try_pop();
+    bool try_push(T value);
+
+    void close();
+
+    // accessors
+    bool is_closed();
+    size_t size();
+    size_t capacity();
+};
+
+} // namespace cxc
+
+#include "channel.cpp"
+
+#endif
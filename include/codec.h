@@ -0,0 +1,98 @@
+#ifndef CXC_CODEC_H
+#define CXC_CODEC_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace cxc
+{
+
+/**
+ * @brief Element codec used by dlist::save / dlist::load.
+ *
+ * The primary template handles trivially copyable types, whose elements are
+ * copied byte for byte in large chunks (bulk = true). Other types need a
+ * specialization, or a codec object passed to save / load, providing:
+ *
+ *     static constexpr bool bulk = false;
+ *     void write(std::ostream &out, const T &value);
+ *     T read(std::istream &in);
+ *
+ * read signals a malformed stream by throwing or by setting the stream's
+ * failbit.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T> struct codec
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "cxc::codec<T> must be specialized for types that are not trivially copyable");
+
+    static constexpr bool bulk = true;
+};
+
+/**
+ * @brief Codec for std::string: a 64-bit length followed by the characters.
+ */
+template <> struct codec<std::string>
+{
+    static constexpr bool bulk = false;
+
+    void write(std::ostream &out, const std::string &value)
+    {
+        uint64_t length = value.size();
+        out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+        out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    std::string read(std::istream &in)
+    {
+        uint64_t length = 0;
+        in.read(reinterpret_cast<char *>(&length), sizeof(length));
+
+        std::string value;
+
+        // grow with the data actually read, a corrupt length must not
+        // allocate gigabytes up front
+        char buffer[4096];
+
+        while (in && length > 0)
+        {
+            size_t part = length < sizeof(buffer) ? static_cast<size_t>(length) : sizeof(buffer);
+            in.read(buffer, static_cast<std::streamsize>(part));
+            value.append(buffer, static_cast<size_t>(in.gcount()));
+            length -= part;
+        }
+
+        return value;
+    }
+};
+
+/**
+ * @brief Header of the binary format written by dlist::save.
+ *
+ * Fields are written in the machine's byte order; the byte order tag makes a
+ * file from a machine of the other endianness fail to load instead of loading
+ * garbage.
+ */
+struct dlist_header
+{
+    static constexpr char magic[8] = {'C', 'X', 'C', 'D', 'L', 'I', 'S', 'T'};
+    static constexpr uint32_t current_version = 1;
+    static constexpr uint32_t byte_order_tag = 0x01020304;
+
+    char file_magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    // sizeof(T) for bulk codecs, 0 otherwise
+    uint64_t element_size;
+    uint64_t count;
+};
+
+} // namespace cxc
+
+#endif
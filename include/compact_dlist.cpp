@@ -0,0 +1,380 @@
+#ifndef CXC_COMPACT_DLIST_TPP
+#define CXC_COMPACT_DLIST_TPP
+
+#include "compact_dlist.h"
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Destructor, destroys every element and frees the blocks.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T, typename Links> compact_dlist<T, Links>::~compact_dlist()
+{
+    clear();
+}
+
+/**
+ * @brief Returns the number of slots of a block.
+ *
+ * @param block The position of the block.
+ * @return 2^min_block_bits for the first block, doubling up to
+ * 2^max_block_bits.
+ */
+template <typename T, typename Links> size_t compact_dlist<T, Links>::block_size(size_t block)
+{
+    if (block == 0)
+        return size_t(1) << min_block_bits;
+
+    if (block <= max_block_bits - min_block_bits)
+        return size_t(1) << (min_block_bits - 1 + block);
+
+    return size_t(1) << max_block_bits;
+}
+
+/**
+ * @brief Returns the slot at an index.
+ *
+ * Block 0 holds the indices below 2^min_block_bits and each following block
+ * up to 2^max_block_bits doubles the indices covered so far, so below that the
+ * number of significant bits of the index gives its block. Further blocks
+ * take the high bits of the index.
+ *
+ * @param index The index of the slot, not 0.
+ * @return Reference to the slot.
+ */
+template <typename T, typename Links>
+typename compact_dlist<T, Links>::Slot &compact_dlist<T, Links>::slot(index_type index)
+{
+    constexpr size_t min_mask = (size_t(1) << min_block_bits) - 1;
+    constexpr size_t max_mask = (size_t(1) << max_block_bits) - 1;
+
+    if (index > max_mask)
+        return blocks[(index >> max_block_bits) + (max_block_bits - min_block_bits)][index & max_mask];
+
+    size_t bits = 32 - static_cast<size_t>(__builtin_clz(static_cast<unsigned>(index | min_mask)));
+    return blocks[bits - min_block_bits][index & (((size_t(1) << (bits - 1)) - 1) | min_mask)];
+}
+
+/**
+ * @brief Constructs an element in a free slot, allocating a new block when
+ * every slot is in use.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return The index of the slot, its links left unset.
+ * @throws std::runtime_error if the list already holds 2^32 - 2 elements.
+ */
+template <typename T, typename Links>
+template <typename... Args>
+typename compact_dlist<T, Links>::index_type compact_dlist<T, Links>::create(Args &&...args)
+{
+    index_type index = free_head;
+
+    if (index != 0)
+    {
+        Slot &s = slot(index);
+        ::new (static_cast<void *>(&s.data)) T(std::forward<Args>(args)...);
+        free_head = Links::free_link(s.links);
+        return index;
+    }
+
+    if (unused > index_type(-1) - 1)
+        throw std::runtime_error("[Error] insert: compact_dlist is full.");
+
+    if (unused >= allocated)
+        reserve(unused);
+
+    index = static_cast<index_type>(unused);
+    ::new (static_cast<void *>(&slot(index).data)) T(std::forward<Args>(args)...);
+    unused++;
+
+    return index;
+}
+
+/**
+ * @brief Destroys the element of a slot and puts the slot on the free list.
+ *
+ * @param index The index of the slot.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::destroy(index_type index)
+{
+    std::destroy_at(&slot(index).data);
+
+    Links::free_link(slot(index).links) = free_head;
+    free_head = index;
+}
+
+/**
+ * @brief Frees every block, the elements must already be destroyed.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::release()
+{
+    for (Slot *block : blocks)
+        delete[] block;
+
+    blocks.clear();
+    free_head = 0;
+    unused = 1;
+    allocated = 0;
+}
+
+/**
+ * @brief Allocates the blocks needed to hold the given number of elements.
+ *
+ * Blocks are never moved, so reserving only saves the allocations themselves;
+ * it is mostly useful to fail early when memory is short.
+ *
+ * @param count The number of elements to make room for.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::reserve(size_t count)
+{
+    // one more slot for the null index
+    while (allocated < count + 1)
+    {
+        size_t slots = block_size(blocks.size());
+        blocks.push_back(new Slot[slots]);
+        allocated += slots;
+    }
+}
+
+/**
+ * @brief Inserts a new element at the head of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::insert_head(T data)
+{
+    emplace_head(std::move(data));
+}
+
+/**
+ * @brief Inserts a new element at the tail of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::insert_tail(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Inserts a new element at the tail of the list, like dlist::insert.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::insert(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Constructs a new element in place at the head of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element.
+ */
+template <typename T, typename Links>
+template <typename... Args>
+T &compact_dlist<T, Links>::emplace_head(Args &&...args)
+{
+    index_type index = create(std::forward<Args>(args)...);
+    Slot &s = slot(index);
+
+    Links::set(s.links, 0, head);
+
+    if (head != 0)
+        Links::set_prev(slot(head).links, 0, index);
+    else
+        tail = index;
+
+    head = index;
+    m_size++;
+
+    return s.data;
+}
+
+/**
+ * @brief Constructs a new element in place at the tail of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element.
+ */
+template <typename T, typename Links>
+template <typename... Args>
+T &compact_dlist<T, Links>::emplace_tail(Args &&...args)
+{
+    index_type index = create(std::forward<Args>(args)...);
+    Slot &s = slot(index);
+
+    Links::set(s.links, tail, 0);
+
+    if (tail != 0)
+        Links::set_next(slot(tail).links, 0, index);
+    else
+        head = index;
+
+    tail = index;
+    m_size++;
+
+    return s.data;
+}
+
+/**
+ * @brief Destroys every element and frees the blocks.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::clear()
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        index_type prev = 0;
+        index_type index = head;
+
+        while (index != 0)
+        {
+            index_type next = Links::next(slot(index).links, prev);
+            std::destroy_at(&slot(index).data);
+            prev = index;
+            index = next;
+        }
+    }
+
+    release();
+
+    head = 0;
+    tail = 0;
+    m_size = 0;
+}
+
+/**
+ * @brief Removes the element at the head of the list, if any.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::remove_head()
+{
+    if (is_empty())
+        return;
+
+    index_type index = head;
+    index_type next = Links::next(slot(index).links, 0);
+
+    if (next != 0)
+        Links::set_prev(slot(next).links, index, 0);
+    else
+        tail = 0;
+
+    head = next;
+    destroy(index);
+    m_size--;
+}
+
+/**
+ * @brief Removes the element at the tail of the list, if any.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::remove_tail()
+{
+    if (is_empty())
+        return;
+
+    index_type index = tail;
+    index_type prev = Links::prev(slot(index).links, 0);
+
+    if (prev != 0)
+        Links::set_next(slot(prev).links, index, 0);
+    else
+        head = 0;
+
+    tail = prev;
+    destroy(index);
+    m_size--;
+}
+
+/**
+ * @brief Checks if the list is empty.
+ *
+ * @return true if the list is empty, false otherwise.
+ */
+template <typename T, typename Links> bool compact_dlist<T, Links>::is_empty()
+{
+    return head == 0;
+}
+
+/**
+ * @brief Returns a reference to the element at the head of the list.
+ *
+ * If the list is empty, a std::runtime_error is thrown.
+ *
+ * @return A const reference to the head element.
+ */
+template <typename T, typename Links> const T &compact_dlist<T, Links>::get_head()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access head data.");
+
+    return slot(head).data;
+}
+
+/**
+ * @brief Returns a reference to the element at the tail of the list.
+ *
+ * If the list is empty, a std::runtime_error is thrown.
+ *
+ * @return A const reference to the tail element.
+ */
+template <typename T, typename Links> const T &compact_dlist<T, Links>::get_tail()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access tail data.");
+
+    return slot(tail).data;
+}
+
+/**
+ * @brief Returns the number of elements in the list.
+ *
+ * @return A const reference to the size of the list.
+ */
+template <typename T, typename Links> const size_t &compact_dlist<T, Links>::size()
+{
+    return m_size;
+}
+
+/**
+ * @brief Returns the number of elements the allocated blocks can hold.
+ *
+ * @return The capacity of the arena.
+ */
+template <typename T, typename Links> size_t compact_dlist<T, Links>::capacity()
+{
+    return allocated == 0 ? 0 : allocated - 1;
+}
+
+/**
+ * @brief Reverses the order of the elements.
+ *
+ * With xor_links the links read the same in both directions, so only the
+ * ends are swapped. With index_links every slot's links are swapped.
+ */
+template <typename T, typename Links> void compact_dlist<T, Links>::reverse()
+{
+    if constexpr (std::is_same_v<Links, index_links>)
+    {
+        for (index_type index = head; index != 0;)
+        {
+            typename Links::Links &links = slot(index).links;
+            std::swap(links.prev, links.next);
+            index = links.prev;
+        }
+    }
+
+    std::swap(head, tail);
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef CXC_COMPACT_DLIST_H
+#define CXC_COMPACT_DLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Link layout of compact_dlist with a 32-bit index per direction.
+ *
+ * Index 0 is the null link. set_prev / set_next take the old value for the
+ * sake of xor_links and ignore it.
+ */
+struct index_links
+{
+    using index_type = uint32_t;
+
+    struct Links
+    {
+        index_type prev = 0;
+        index_type next = 0;
+    };
+
+    static index_type prev(const Links &links, index_type)
+    {
+        return links.prev;
+    }
+
+    static index_type next(const Links &links, index_type)
+    {
+        return links.next;
+    }
+
+    static void set(Links &links, index_type prev, index_type next)
+    {
+        links.prev = prev;
+        links.next = next;
+    }
+
+    static void set_prev(Links &links, index_type, index_type prev)
+    {
+        links.prev = prev;
+    }
+
+    static void set_next(Links &links, index_type, index_type next)
+    {
+        links.next = next;
+    }
+
+    static index_type &free_link(Links &links)
+    {
+        return links.next;
+    }
+};
+
+/**
+ * @brief Link layout of compact_dlist keeping prev ^ next in a single 32-bit
+ * field.
+ *
+ * A neighbour is only reachable from the other one, so traversal carries the
+ * index it came from. Reversing the list is O(1).
+ */
+struct xor_links
+{
+    using index_type = uint32_t;
+
+    struct Links
+    {
+        index_type both = 0;
+    };
+
+    static index_type prev(const Links &links, index_type next)
+    {
+        return links.both ^ next;
+    }
+
+    static index_type next(const Links &links, index_type prev)
+    {
+        return links.both ^ prev;
+    }
+
+    static void set(Links &links, index_type prev, index_type next)
+    {
+        links.both = prev ^ next;
+    }
+
+    static void set_prev(Links &links, index_type old_prev, index_type prev)
+    {
+        links.both ^= old_prev ^ prev;
+    }
+
+    static void set_next(Links &links, index_type old_next, index_type next)
+    {
+        links.both ^= old_next ^ next;
+    }
+
+    static index_type &free_link(Links &links)
+    {
+        return links.both;
+    }
+};
+
+/**
+ * @brief Doubly linked list with its nodes in a block arena, linked by 32-bit
+ * indices.
+ *
+ * A slot holds the element next to its links (8 bytes with index_links, 4 with
+ * xor_links), so a compact_dlist<float> takes 12 or 8 bytes per element where
+ * a dlist<float> node takes 24. Slots are carved from blocks that never move,
+ * so references to elements stay valid until the element is removed, and
+ * removed slots are reused first. The first block holds 2^min_block_bits
+ * slots and the following ones double up to 2^max_block_bits, so a small
+ * list stays small. A list holds at most 2^32 - 2 elements.
+ *
+ * Only the ends of the list are modified: insertion and removal at the head
+ * and tail, clear and reverse. There are no positional or iterator-based
+ * insertions and removals as in dlist; iteration goes both ways.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam Links The link layout, index_links or xor_links.
+ */
+template <typename T, typename Links = index_links> struct compact_dlist
+{
+  public:
+    using index_type = typename Links::index_type;
+
+    static constexpr size_t min_block_bits = 6;
+    static constexpr size_t max_block_bits = 14;
+
+  private:
+    struct Slot
+    {
+        typename Links::Links links;
+
+        union
+        {
+            T data;
+        };
+
+        Slot()
+        {
+        }
+
+        ~Slot()
+        {
+        }
+    };
+
+    size_t m_size = 0;
+    index_type head = 0;
+    index_type tail = 0;
+    index_type free_head = 0;
+    // first slot never handed out, slot 0 is the null index
+    size_t unused = 1;
+    // slots in the allocated blocks, the null slot included
+    size_t allocated = 0;
+    std::vector<Slot *> blocks{};
+
+    static size_t block_size(size_t block);
+
+    Slot &slot(index_type index);
+
+    template <typename... Args> index_type create(Args &&...args);
+
+    void destroy(index_type index);
+
+    void release();
+
+  public:
+    struct Iterator;
+
+    compact_dlist() = default;
+    compact_dlist(const compact_dlist &) = delete;
+    compact_dlist &operator=(const compact_dlist &) = delete;
+    ~compact_dlist();
+
+    void reserve(size_t count);
+
+    //  inseration / deletion
+    void insert_head(T data);
+    void insert_tail(T data);
+    void insert(T data);
+
+    template <typename... Args> T &emplace_head(Args &&...args);
+    template <typename... Args> T &emplace_tail(Args &&...args);
+
+    void clear();
+    void remove_head();
+    void remove_tail();
+
+    // accessors
+    bool is_empty();
+    const T &get_head();
+    const T &get_tail();
+    const size_t &size();
+    size_t capacity();
+
+    /**
+     * @brief Returns the bytes taken by one element and its links.
+     *
+     * @return The size of a slot.
+     */
+    static constexpr size_t slot_size()
+    {
+        return sizeof(Slot);
+    }
+
+    // misc
+    void reverse();
+
+    /**
+     * @brief Bidirectional iterator over a compact_dlist.
+     *
+     * Carries the index of the previous slot next to the current one, which
+     * xor_links needs to step in either direction. end() can be decremented
+     * to reach the last element.
+     */
+    struct Iterator
+    {
+        using pointer = T *;
+        using value_type = T;
+        using reference = T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+      private:
+        compact_dlist *list = nullptr;
+        index_type prev = 0;
+        index_type current = 0;
+
+      public:
+        Iterator() = default;
+
+        Iterator(compact_dlist *_list, index_type _prev, index_type _current)
+            : list(_list), prev(_prev), current(_current)
+        {
+        }
+
+        T &operator*() const
+        {
+            return list->slot(current).data;
+        }
+
+        T *operator->() const
+        {
+            return &list->slot(current).data;
+        }
+
+        Iterator &operator++()
+        {
+            index_type next = Links::next(list->slot(current).links, prev);
+            prev = current;
+            current = next;
+            return *this;
+        }
+
+        Iterator &operator--()
+        {
+            index_type before = Links::prev(list->slot(prev).links, current);
+            current = prev;
+            prev = before;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return current == other.current;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return current != other.current;
+        }
+    };
+
+    /**
+     * @brief Returns an iterator pointing to the first element in the list.
+     *
+     * @return An iterator pointing to the first element in the list.
+     */
+    Iterator begin()
+    {
+        return Iterator(this, 0, head);
+    }
+
+    /**
+     * @brief Returns an iterator referring to the past-the-end element in the
+     * list.
+     *
+     * @return An iterator referring to the past-the-end element in the list.
+     */
+    Iterator end()
+    {
+        return Iterator(this, tail, 0);
+    }
+};
+
+} // namespace cxc
+
+#include "compact_dlist.cpp"
+
+#endif
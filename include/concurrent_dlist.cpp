@@ -0,0 +1,414 @@
+#ifndef CXC_CONCURRENT_DLIST_TPP
+#define CXC_CONCURRENT_DLIST_TPP
+
+#include "concurrent_dlist.h"
+
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Frees the nodes left in the deque. No other thread may use the deque
+ * anymore.
+ *
+ * @tparam T The type of elements stored in the deque.
+ */
+template <typename T> concurrent_dlist<T>::~concurrent_dlist()
+{
+    Anchor current = anchor.load();
+
+    while (current.status() != STABLE)
+    {
+        stabilize(current, this_thread_hazards());
+        current = anchor.load();
+    }
+
+    this_thread_hazards().clear();
+
+    // links beyond the rightmost node may point to popped nodes, stop there
+    Node<T> *last = current.right_node();
+    Node<T> *node = current.left;
+
+    while (node != nullptr)
+    {
+        Node<T> *next = node == last ? nullptr : node->next;
+        delete node;
+        node = next;
+    }
+}
+
+/**
+ * @brief Packs the ends of the deque and its status into an anchor value.
+ *
+ * @param left The leftmost node.
+ * @param right The rightmost node.
+ * @param status The status of the deque.
+ * @return The anchor value.
+ */
+template <typename T>
+typename concurrent_dlist<T>::Anchor concurrent_dlist<T>::make_anchor(Node<T> *left, Node<T> *right, Status status)
+{
+    return Anchor{left, reinterpret_cast<uintptr_t>(right) | status};
+}
+
+/**
+ * @brief Gives atomic access to a link of a node.
+ *
+ * @param field The prev or next field of a node.
+ * @return An atomic reference to the field.
+ */
+template <typename T> std::atomic_ref<Node<T> *> concurrent_dlist<T>::link(Node<T> *&field)
+{
+    return std::atomic_ref<Node<T> *>(field);
+}
+
+/**
+ * @brief Deleter of retired nodes.
+ *
+ * @param node The node to free.
+ */
+template <typename T> void concurrent_dlist<T>::free_node(void *node)
+{
+    delete static_cast<Node<T> *>(node);
+}
+
+/**
+ * @brief Finishes the push an unstable anchor records.
+ *
+ * @param current The anchor value read by the caller.
+ * @param hazards The hazard record of the calling thread.
+ */
+template <typename T> void concurrent_dlist<T>::stabilize(Anchor current, hazard_record &hazards)
+{
+    if (current.status() == RPUSH)
+        stabilize_right(current, hazards);
+    else
+        stabilize_left(current, hazards);
+}
+
+/**
+ * @brief Links the node before the rightmost one to it after a right push,
+ * then marks the anchor stable.
+ *
+ * Gives up as soon as the anchor changes, the thread that changed it has
+ * stabilized it first.
+ *
+ * @param current The anchor value read by the caller, with status RPUSH.
+ * @param hazards The hazard record of the calling thread.
+ */
+template <typename T> void concurrent_dlist<T>::stabilize_right(Anchor current, hazard_record &hazards)
+{
+    Node<T> *right = current.right_node();
+
+    hazards.protect(0, right);
+
+    if (!(anchor.load() == current))
+        return;
+
+    Node<T> *prev = link(right->prev).load();
+
+    hazards.protect(1, prev);
+
+    if (!(anchor.load() == current))
+        return;
+
+    Node<T> *prev_next = link(prev->next).load();
+
+    if (prev_next != right)
+    {
+        if (!(anchor.load() == current))
+            return;
+
+        if (!link(prev->next).compare_exchange_strong(prev_next, right))
+            return;
+    }
+
+    anchor.compare_exchange_strong(current, make_anchor(current.left, right, STABLE));
+}
+
+/**
+ * @brief Links the node after the leftmost one to it after a left push, then
+ * marks the anchor stable.
+ *
+ * @param current The anchor value read by the caller, with status LPUSH.
+ * @param hazards The hazard record of the calling thread.
+ */
+template <typename T> void concurrent_dlist<T>::stabilize_left(Anchor current, hazard_record &hazards)
+{
+    Node<T> *left = current.left;
+
+    hazards.protect(0, left);
+
+    if (!(anchor.load() == current))
+        return;
+
+    Node<T> *next = link(left->next).load();
+
+    hazards.protect(1, next);
+
+    if (!(anchor.load() == current))
+        return;
+
+    Node<T> *next_prev = link(next->prev).load();
+
+    if (next_prev != left)
+    {
+        if (!(anchor.load() == current))
+            return;
+
+        if (!link(next->prev).compare_exchange_strong(next_prev, left))
+            return;
+    }
+
+    anchor.compare_exchange_strong(current, make_anchor(left, current.right_node(), STABLE));
+}
+
+/**
+ * @brief Publishes a new node at the right end of the deque.
+ *
+ * @param node The new node, not shared yet.
+ */
+template <typename T> void concurrent_dlist<T>::push_right(Node<T> *node)
+{
+    hazard_record &hazards = this_thread_hazards();
+
+    while (true)
+    {
+        Anchor current = anchor.load();
+        Node<T> *right = current.right_node();
+
+        if (right == nullptr)
+        {
+            if (anchor.compare_exchange_weak(current, make_anchor(node, node, STABLE)))
+                break;
+        }
+        else if (current.status() == STABLE)
+        {
+            node->prev = right;
+
+            Anchor pushed = make_anchor(current.left, node, RPUSH);
+
+            if (anchor.compare_exchange_weak(current, pushed))
+            {
+                stabilize_right(pushed, hazards);
+                break;
+            }
+        }
+        else
+        {
+            stabilize(current, hazards);
+        }
+    }
+
+    hazards.clear();
+}
+
+/**
+ * @brief Publishes a new node at the left end of the deque.
+ *
+ * @param node The new node, not shared yet.
+ */
+template <typename T> void concurrent_dlist<T>::push_left(Node<T> *node)
+{
+    hazard_record &hazards = this_thread_hazards();
+
+    while (true)
+    {
+        Anchor current = anchor.load();
+        Node<T> *left = current.left;
+
+        if (left == nullptr)
+        {
+            if (anchor.compare_exchange_weak(current, make_anchor(node, node, STABLE)))
+                break;
+        }
+        else if (current.status() == STABLE)
+        {
+            node->next = left;
+
+            Anchor pushed = make_anchor(node, current.right_node(), LPUSH);
+
+            if (anchor.compare_exchange_weak(current, pushed))
+            {
+                stabilize_left(pushed, hazards);
+                break;
+            }
+        }
+        else
+        {
+            stabilize(current, hazards);
+        }
+    }
+
+    hazards.clear();
+}
+
+/**
+ * @brief Inserts an element at the head (left end) of the deque.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void concurrent_dlist<T>::insert_head(T data)
+{
+    emplace_head(std::move(data));
+}
+
+/**
+ * @brief Inserts an element at the tail (right end) of the deque.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void concurrent_dlist<T>::insert_tail(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Constructs an element in place at the head of the deque.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ */
+template <typename T> template <typename... Args> void concurrent_dlist<T>::emplace_head(Args &&...args)
+{
+    push_left(new Node<T>(std::in_place, std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Constructs an element in place at the tail of the deque.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ */
+template <typename T> template <typename... Args> void concurrent_dlist<T>::emplace_tail(Args &&...args)
+{
+    push_right(new Node<T>(std::in_place, std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Removes and returns the element at the tail of the deque.
+ *
+ * @return The element, or std::nullopt if the deque was empty.
+ */
+template <typename T> std::optional<T> concurrent_dlist<T>::pop_tail()
+{
+    hazard_record &hazards = this_thread_hazards();
+    Node<T> *right;
+
+    while (true)
+    {
+        Anchor current = anchor.load();
+        right = current.right_node();
+
+        if (right == nullptr)
+        {
+            hazards.clear();
+            return std::nullopt;
+        }
+
+        hazards.protect(0, right);
+
+        if (!(anchor.load() == current))
+            continue;
+
+        if (right == current.left)
+        {
+            if (anchor.compare_exchange_strong(current, make_anchor(nullptr, nullptr, STABLE)))
+                break;
+        }
+        else if (current.status() == STABLE)
+        {
+            Node<T> *prev = link(right->prev).load();
+
+            if (anchor.compare_exchange_strong(current, make_anchor(current.left, prev, STABLE)))
+                break;
+        }
+        else
+        {
+            stabilize(current, hazards);
+        }
+    }
+
+    // the node is ours now, other threads may only still read its links
+    std::optional<T> data(std::move(right->data));
+
+    hazards.clear();
+    hazards.retire(right, &free_node);
+
+    return data;
+}
+
+/**
+ * @brief Removes and returns the element at the head of the deque.
+ *
+ * @return The element, or std::nullopt if the deque was empty.
+ */
+template <typename T> std::optional<T> concurrent_dlist<T>::pop_head()
+{
+    hazard_record &hazards = this_thread_hazards();
+    Node<T> *left;
+
+    while (true)
+    {
+        Anchor current = anchor.load();
+        left = current.left;
+
+        if (left == nullptr)
+        {
+            hazards.clear();
+            return std::nullopt;
+        }
+
+        hazards.protect(0, left);
+
+        if (!(anchor.load() == current))
+            continue;
+
+        if (left == current.right_node())
+        {
+            if (anchor.compare_exchange_strong(current, make_anchor(nullptr, nullptr, STABLE)))
+                break;
+        }
+        else if (current.status() == STABLE)
+        {
+            Node<T> *next = link(left->next).load();
+
+            if (anchor.compare_exchange_strong(current, make_anchor(next, current.right_node(), STABLE)))
+                break;
+        }
+        else
+        {
+            stabilize(current, hazards);
+        }
+    }
+
+    std::optional<T> data(std::move(left->data));
+
+    hazards.clear();
+    hazards.retire(left, &free_node);
+
+    return data;
+}
+
+/**
+ * @brief Checks if the deque is empty at the time of the call.
+ *
+ * @return true if the deque is empty, false otherwise.
+ */
+template <typename T> bool concurrent_dlist<T>::is_empty()
+{
+    return anchor.load().left == nullptr;
+}
+
+/**
+ * @brief Checks if the anchor is updated without a lock on this platform.
+ *
+ * @return true if the double-width compare-and-swap is lock-free.
+ */
+template <typename T> bool concurrent_dlist<T>::is_lock_free()
+{
+    return anchor.is_lock_free();
+}
+
+} // namespace cxc
+
+#endif
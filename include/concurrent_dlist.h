@@ -0,0 +1,112 @@
+#ifndef CXC_CONCURRENT_DLIST_H
+#define CXC_CONCURRENT_DLIST_H
+
+#include "hazard.h"
+#include "node.h"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace cxc
+{
+
+/**
+ * @brief Lock-free doubly linked deque for multiple producers and consumers.
+ *
+ * Implements the deque of M. M. Michael, "CAS-Based Lock-Free Algorithm for
+ * Shared Deques" (Euro-Par 2003). The head and tail pointers and a status
+ * word form a single anchor updated with a double-width compare-and-swap: a
+ * push swings the anchor to the new node and marks it unstable, and the
+ * neighbour's link is fixed afterwards by whichever thread sees the unstable
+ * anchor first. Popped nodes are reclaimed through hazard pointers.
+ *
+ * Nodes are plain Node<T>, their prev / next links are accessed through
+ * std::atomic_ref. On x86-64 the anchor needs cmpxchg16b, reached through
+ * libatomic (link with -latomic). GCC reports 16-byte atomics as not
+ * lock-free even when libatomic picks cmpxchg16b at run time, so
+ * is_lock_free() can be false there.
+ *
+ * There is no size(): a shared counter would add a second contended cache
+ * line to every operation.
+ *
+ * @tparam T The type of elements stored in the deque.
+ */
+template <typename T> struct concurrent_dlist
+{
+  private:
+    enum Status : uintptr_t
+    {
+        STABLE = 0,
+        RPUSH = 1,
+        LPUSH = 2
+    };
+
+    struct alignas(2 * sizeof(void *)) Anchor
+    {
+        Node<T> *left;
+        // rightmost node, with the Status in its low bits
+        uintptr_t right;
+
+        Node<T> *right_node() const
+        {
+            return reinterpret_cast<Node<T> *>(right & ~uintptr_t(3));
+        }
+
+        Status status() const
+        {
+            return static_cast<Status>(right & 3);
+        }
+
+        bool operator==(const Anchor &other) const
+        {
+            return left == other.left && right == other.right;
+        }
+    };
+
+    static_assert(alignof(Node<T>) >= 4, "the anchor keeps its status in the low bits of a node pointer");
+
+    std::atomic<Anchor> anchor{Anchor{nullptr, 0}};
+
+    static Anchor make_anchor(Node<T> *left, Node<T> *right, Status status);
+
+    static std::atomic_ref<Node<T> *> link(Node<T> *&field);
+
+    static void free_node(void *node);
+
+    void push_right(Node<T> *node);
+
+    void push_left(Node<T> *node);
+
+    void stabilize(Anchor current, hazard_record &hazards);
+
+    void stabilize_right(Anchor current, hazard_record &hazards);
+
+    void stabilize_left(Anchor current, hazard_record &hazards);
+
+  public:
+    concurrent_dlist() = default;
+    concurrent_dlist(const concurrent_dlist &) = delete;
+    concurrent_dlist &operator=(const concurrent_dlist &) = delete;
+    ~concurrent_dlist();
+
+    // inseration / deletion
+    void insert_head(T data);
+    void insert_tail(T data);
+
+    template <typename... Args> void emplace_head(Args &&...args);
+    template <typename... Args> void emplace_tail(Args &&...args);
+
+    std::optional<T> pop_head();
+    std::optional<T> pop_tail();
+
+    // accessors
+    bool is_empty();
+    bool is_lock_free();
+};
+
+} // namespace cxc
+
+#include "concurrent_dlist.cpp"
+
+#endif
@@ -3,6 +3,16 @@
 
 #include "dlist.h"
 
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace cxc
 {
 
@@ -14,94 +24,425 @@ namespace cxc
  * multiple values.
  * @param args The arguments used to initialize the list.
  */
-template <typename T> template <typename... Args> dlist<T>::dlist(Args... args)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename... Args>
+dlist<T, Alloc, Hooks, Index>::dlist(Args &&...args)
 {
-    init_events();
-    init(args...);
+    Hooks::bind(m_size);
+    init(std::forward<Args>(args)...);
 }
 
 /**
- * @brief Helper function for initializing the dlist.
+ * @brief Constructor for an empty dlist creating its nodes with the given
+ * allocator.
  *
- * This function recursively initializes the list with the given arguments.
+ * Passing a copy of another list's node_pool makes both lists share their
+ * nodes' arena, so that splice and merge between them relink nodes in O(1).
  *
  * @tparam T The type of elements stored in the list.
- * @tparam Args Variadic template parameters for initializing the list with
- * multiple values.
- * @param first The first argument used to initialize the list.
- * @param rest The remaining arguments used to initialize the list.
+ * @param alloc The node allocator.
  */
-template <typename T> template <typename... Args> void dlist<T>::init(T first, Args... rest)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+dlist<T, Alloc, Hooks, Index>::dlist(std::allocator_arg_t, Alloc alloc) : m_alloc(std::move(alloc))
 {
-    if (is_empty())
-    {
-        Node<T> *new_node = new Node<T>(first, nullptr, nullptr);
-        head = new_node;
-        tail = new_node;
+    Hooks::bind(m_size);
+}
+
+/**
+ * @brief Move constructor, takes the elements of another list and leaves it
+ * empty.
+ *
+ * With an allocator that can be move-constructed without throwing, the
+ * nodes, the allocator and the index are taken over in O(1), and iterators
+ * and references to the elements stay valid. An inline_pool cannot hand over
+ * its slots, so the elements are then moved one by one into new nodes.
+ * Either way the hooks are not moved: this list's hooks are bound to its own
+ * count, and no event is triggered.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param other The list to take the elements from.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+dlist<T, Alloc, Hooks, Index>::dlist(dlist &&other) noexcept(std::is_nothrow_move_constructible_v<Alloc>)
+    : m_alloc(moved_allocator(other.m_alloc))
+{
+    Hooks::bind(m_size);
+
+    if constexpr (std::is_nothrow_move_constructible_v<Alloc>)
+        steal(other);
+    else
+        take(other);
+}
+
+/**
+ * @brief Move assignment, destroys the elements of this list and takes those
+ * of another list, leaving it empty (see the move constructor).
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param other The list to take the elements from.
+ * @return Reference to this list.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+dlist<T, Alloc, Hooks, Index> &dlist<T, Alloc, Hooks, Index>::operator=(dlist &&other) noexcept(
+    std::is_nothrow_move_assignable_v<Alloc>)
+{
+    if (&other == this)
+        return *this;
+
+    clear();
+    take(other);
+
+    return *this;
+}
+
+/**
+ * @brief Destructor for the dlist struct, destroys every remaining node.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index> dlist<T, Alloc, Hooks, Index>::~dlist()
+{
+    clear();
+}
+
+/**
+ * @brief Returns the allocator the list creates its nodes with.
+ *
+ * Nodes handed to insert_head(Node<T> *) / insert_tail(Node<T> *) must come
+ * from this allocator, since the list destroys them through it.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @return Reference to the node allocator.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+Alloc &dlist<T, Alloc, Hooks, Index>::get_allocator()
+{
+    return m_alloc;
+}
+
+/**
+ * @brief Wraps a node into an iterator that knows the list's tail and
+ * counts its steps in the list's statistics.
+ *
+ * @param node The node to point to, nullptr for end().
+ * @return The iterator.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+typename dlist<T, Alloc, Hooks, Index>::Iterator dlist<T, Alloc, Hooks, Index>::iterator_at(Node<T> *node)
+{
+#ifdef CXC_DLIST_STATS
+    return Iterator(node, &tail, &m_stats.iterator_steps);
+#else
+    return Iterator(node, &tail);
+#endif
+}
+
+/**
+ * @brief Returns the allocator the move constructor starts with: the other
+ * list's, moved, if that cannot throw, a new one otherwise.
+ *
+ * @param other The allocator of the list being moved from.
+ * @return The allocator of the new list.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+Alloc dlist<T, Alloc, Hooks, Index>::moved_allocator(Alloc &other)
+{
+    if constexpr (std::is_nothrow_move_constructible_v<Alloc>)
+        return std::move(other);
+    else
+        return Alloc{};
+}
 
-        _events.trigger(Events::INCREASE_COUNT);
+/**
+ * @brief Takes over the nodes and the index of another list, whose
+ * allocator this list already uses, leaving the other list empty.
+ *
+ * @param other The list to take the nodes from.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::steal(dlist &other)
+{
+    m_index = std::move(other.m_index);
+
+    head = std::exchange(other.head, nullptr);
+    tail = std::exchange(other.tail, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+}
+
+/**
+ * @brief Takes the elements of another list into this empty list, leaving
+ * the other list empty.
+ *
+ * @param other The list to take the elements from.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::take(dlist &other)
+{
+    if constexpr (std::is_nothrow_move_assignable_v<Alloc>)
+    {
+        m_alloc = std::move(other.m_alloc);
+        steal(other);
     }
     else
     {
-        Node<T> *new_node = new Node<T>(first, tail, nullptr);
-        tail->next = new_node;
-        tail = new_node;
+        for (Node<T> *node = other.head; node != nullptr; node = node->next)
+            emplace_tail(std::move(node->data));
 
-        _events.trigger(Events::INCREASE_COUNT);
+        other.clear();
     }
+}
 
-    init(rest...);
+/**
+ * @brief Wraps a node into a const iterator that knows the list's tail and
+ * counts its steps in the list's statistics.
+ *
+ * @param node The node to point to, nullptr for end().
+ * @return The const iterator.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+typename dlist<T, Alloc, Hooks, Index>::ConstIterator dlist<T, Alloc, Hooks, Index>::iterator_at(
+    const Node<T> *node) const
+{
+#ifdef CXC_DLIST_STATS
+    return ConstIterator(node, &tail, &m_stats.iterator_steps);
+#else
+    return ConstIterator(node, &tail);
+#endif
 }
 
 /**
- * @brief Base case for the recursive initialization of the dlist.
+ * @brief Writes the list to a binary stream.
  *
- * @tparam T The type of elements stored in the list.
+ * A dlist_header is followed by the elements from head to tail. Elements of a
+ * bulk codec (trivially copyable T by default) are gathered into 64 KiB
+ * chunks, each written with a single call; others are written one by one
+ * through the codec. The data is in the machine's byte order.
+ *
+ * @tparam Codec The element codec, codec<T> by default.
+ * @param out The stream to write to, opened in binary mode.
+ * @param element_codec The codec object.
+ * @throws std::runtime_error if writing fails.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Codec>
+void dlist<T, Alloc, Hooks, Index>::save(std::ostream &out, Codec element_codec)
+{
+    dlist_header header{};
+    std::copy(std::begin(dlist_header::magic), std::end(dlist_header::magic), header.file_magic);
+    header.version = dlist_header::current_version;
+    header.byte_order = dlist_header::byte_order_tag;
+    header.element_size = Codec::bulk ? sizeof(T) : 0;
+    header.count = m_size;
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if constexpr (Codec::bulk)
+    {
+        constexpr size_t chunk = sizeof(T) < 65536 ? 65536 / sizeof(T) : 1;
+        std::vector<char> buffer(chunk * sizeof(T));
+
+        Node<T> *node = head;
+
+        while (node != nullptr && out)
+        {
+            size_t filled = 0;
+
+            for (; node != nullptr && filled < chunk; node = node->next, filled++)
+                std::memcpy(buffer.data() + filled * sizeof(T), &node->data, sizeof(T));
+
+            out.write(buffer.data(), static_cast<std::streamsize>(filled * sizeof(T)));
+        }
+    }
+    else
+    {
+        for (Node<T> *node = head; node != nullptr && out; node = node->next)
+            element_codec.write(out, node->data);
+    }
+
+    if (!out)
+        throw std::runtime_error("[Error] save: writing to the stream failed.");
+}
+
+/**
+ * @brief Appends the elements of a stream written by save() at the tail of
+ * the list.
+ *
+ * The nodes are chained while reading, in chunks of 64 KiB for bulk codecs
+ * so memory stays bounded whatever the stream size, and linked into the list
+ * at once: the size is updated a single time and the index rebuilt lazily.
+ * On error the list is left unchanged.
+ *
+ * @tparam Codec The element codec, the one the stream was saved with.
+ * @param in The stream to read from, opened in binary mode.
+ * @param element_codec The codec object.
+ * @throws std::runtime_error if the stream is not a dlist of this element
+ * type and codec, or is truncated.
  */
-template <typename T> void dlist<T>::init()
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Codec>
+void dlist<T, Alloc, Hooks, Index>::load(std::istream &in, Codec element_codec)
 {
+    dlist_header header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    if (!in || !std::equal(std::begin(dlist_header::magic), std::end(dlist_header::magic), header.file_magic))
+        throw std::runtime_error("[Error] load: the stream does not hold a dlist.");
+
+    if (header.version != dlist_header::current_version || header.byte_order != dlist_header::byte_order_tag)
+        throw std::runtime_error("[Error] load: unsupported format version or byte order.");
+
+    if (header.element_size != (Codec::bulk ? sizeof(T) : 0))
+        throw std::runtime_error("[Error] load: the stream was saved with another element type or codec.");
+
+    Node<T> *chain_head = nullptr;
+    Node<T> *chain_tail = nullptr;
+    size_t count = 0;
+
+    auto append = [&](Node<T> *node) {
+        CXC_DLIST_STAT(m_stats.allocations++;)
+
+        node->prev = chain_tail;
+
+        if (chain_tail != nullptr)
+            chain_tail->next = node;
+        else
+            chain_head = node;
+
+        chain_tail = node;
+        count++;
+    };
+
+    try
+    {
+        if constexpr (Codec::bulk)
+        {
+            constexpr size_t chunk = sizeof(T) < 65536 ? 65536 / sizeof(T) : 1;
+            std::vector<char> buffer(chunk * sizeof(T));
+
+            while (count < header.count)
+            {
+                size_t wanted = std::min<uint64_t>(chunk, header.count - count);
+                in.read(buffer.data(), static_cast<std::streamsize>(wanted * sizeof(T)));
+
+                if (!in)
+                    throw std::runtime_error("[Error] load: the stream is truncated.");
+
+                for (size_t i = 0; i < wanted; i++)
+                {
+                    // T may lack a default constructor, copy its bytes into raw storage
+                    alignas(T) unsigned char bytes[sizeof(T)];
+                    std::memcpy(bytes, buffer.data() + i * sizeof(T), sizeof(T));
+                    append(m_alloc.create(*std::launder(reinterpret_cast<T *>(bytes))));
+                }
+            }
+        }
+        else
+        {
+            while (count < header.count)
+            {
+                T value = element_codec.read(in);
+
+                if (!in)
+                    throw std::runtime_error("[Error] load: the stream is truncated.");
+
+                append(m_alloc.create(std::move(value)));
+            }
+        }
+    }
+    catch (...)
+    {
+        while (chain_head != nullptr)
+        {
+            Node<T> *next = chain_head->next;
+            m_alloc.destroy(chain_head);
+            CXC_DLIST_STAT(m_stats.frees++;)
+            chain_head = next;
+        }
+
+        throw;
+    }
+
+    if (count == 0)
+        return;
+
+    link_before(nullptr, chain_head, chain_tail);
+
+    Hooks::on_increase(m_size, count);
+    m_index.invalidate();
 }
 
 /**
- * @brief Increases the count of elements in the list.
+ * @brief Takes a snapshot of the list's statistics.
+ *
+ * The counters stay 0 unless CXC_DLIST_STATS is defined; the size and memory
+ * figures are always filled in.
  *
  * @tparam T The type of elements stored in the list.
+ * @return The statistics.
  */
-template <typename T> void dlist<T>::increase()
+template <typename T, typename Alloc, typename Hooks, typename Index>
+dlist_stats dlist<T, Alloc, Hooks, Index>::stats()
 {
-    m_size++;
+    dlist_stats snapshot{};
+
+#ifdef CXC_DLIST_STATS
+    snapshot.enabled = true;
+    snapshot.allocations = m_stats.allocations;
+    snapshot.frees = m_stats.frees;
+    snapshot.positional_ops = m_stats.positional_ops;
+    snapshot.nodes_traversed = m_index.traversed;
+    snapshot.iterator_steps = m_stats.iterator_steps;
+#endif
+
+    snapshot.size = m_size;
+    snapshot.heap_bytes = m_alloc.footprint(m_size);
+
+    if (m_size != 0)
+        snapshot.overhead_per_element =
+            static_cast<double>(snapshot.heap_bytes) / static_cast<double>(m_size) - static_cast<double>(sizeof(T));
+
+    return snapshot;
 }
 
 /**
- * @brief Decreases the count of elements in the list.
+ * @brief Resets the statistics counters to 0.
  *
  * @tparam T The type of elements stored in the list.
  */
-template <typename T> void dlist<T>::decrease()
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::reset_stats()
 {
-    m_size--;
+    CXC_DLIST_STAT(m_stats = dlist_counters{}; m_index.traversed = 0;)
 }
 
 /**
- * @brief Sets the count of elements to zero.
+ * @brief Helper function for initializing the dlist.
+ *
+ * This function recursively initializes the list with the given arguments,
+ * moving rvalues into the nodes.
  *
  * @tparam T The type of elements stored in the list.
+ * @tparam First The type of the first argument.
+ * @tparam Rest Variadic template parameters for initializing the list with
+ * multiple values.
+ * @param first The first argument used to initialize the list.
+ * @param rest The remaining arguments used to initialize the list.
  */
-template <typename T> void dlist<T>::empty()
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename First, typename... Rest>
+void dlist<T, Alloc, Hooks, Index>::init(First &&first, Rest &&...rest)
 {
-    m_size = 0;
+    insert_tail(std::forward<First>(first));
+    init(std::forward<Rest>(rest)...);
 }
 
 /**
- * @brief Initializes event handlers for the doubly linked list.
+ * @brief Base case for the recursive initialization of the dlist.
  *
  * @tparam T The type of elements stored in the list.
  */
-template <typename T> void dlist<T>::init_events()
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::init()
 {
-    _events.add(Events::EMPTY_COUNT, [this]() { empty(); });
-    _events.add(Events::INCREASE_COUNT, [this]() { increase(); });
-    _events.add(Events::DECREASE_COUNT, [this]() { decrease(); });
 }
 
 /**
@@ -109,7 +450,7 @@ template <typename T> void dlist<T>::init_events()
  *
  * @tparam T The type of elements stored in the list.
  */
-template <typename T> void dlist<T>::print()
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::print()
 {
     Node<T> *ptr = head;
 
@@ -126,7 +467,7 @@ template <typename T> void dlist<T>::print()
  * @tparam T The type of data stored in the list.
  * @return true if the list is empty, false otherwise.
  */
-template <typename T> bool dlist<T>::is_empty()
+template <typename T, typename Alloc, typename Hooks, typename Index> bool dlist<T, Alloc, Hooks, Index>::is_empty()
 {
     return head == nullptr || tail == nullptr;
 }
@@ -137,7 +478,7 @@ template <typename T> bool dlist<T>::is_empty()
  * @tparam T The type of data stored in the list.
  * @return true if the list contains only one element, false otherwise.
  */
-template <typename T> bool dlist<T>::only_element()
+template <typename T, typename Alloc, typename Hooks, typename Index> bool dlist<T, Alloc, Hooks, Index>::only_element()
 {
     return head == tail;
 }
@@ -152,20 +493,45 @@ template <typename T> bool dlist<T>::only_element()
  * @tparam T The type of data stored in the nodes.
  * @param data The data to be stored in the new node.
  */
-template <typename T> void dlist<T>::insert_head(T data)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::insert_head(T data)
+{
+    emplace_head(std::move(data));
+}
+
+/**
+ * @brief Constructs a new element in place at the head of the doubly linked
+ * list.
+ *
+ * @tparam T The type of data stored in the nodes.
+ * @tparam Args The types of the constructor arguments.
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename... Args>
+T &dlist<T, Alloc, Hooks, Index>::emplace_head(Args &&...args)
 {
-    insert_head(Node<T>::create(data, nullptr, nullptr));
+    Node<T> *node = m_alloc.create(std::forward<Args>(args)...);
+    CXC_DLIST_STAT(m_stats.allocations++;)
+    insert_head(node);
+
+    return node->data;
 }
 
 /**
  * @brief Inserts the given node at the head of the doubly linked list.
  *
  * This function inserts the given node at the head of the doubly linked list.
+ * The list takes ownership of the node and destroys it through its allocator,
+ * so the node must come from get_allocator().create(). Objects owned by the
+ * caller belong in an intrusive_dlist instead.
  *
  * @tparam T The type of data stored in the nodes.
  * @param node Pointer to the node to be inserted.
  */
-template <typename T> void dlist<T>::insert_head(Node<T> *node)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::insert_head(Node<T> *node)
 {
     if (!is_empty())
     {
@@ -174,7 +540,8 @@ template <typename T> void dlist<T>::insert_head(Node<T> *node)
         node->prev = nullptr;
         head = node;
 
-        _events.trigger(Events::INCREASE_COUNT);
+        Hooks::on_increase(m_size);
+        m_index.inserted(0, node);
     }
     else
     {
@@ -183,7 +550,8 @@ template <typename T> void dlist<T>::insert_head(Node<T> *node)
         head = node;
         tail = node;
 
-        _events.trigger(Events::INCREASE_COUNT);
+        Hooks::on_increase(m_size);
+        m_index.inserted(0, node);
     }
 }
 
@@ -197,28 +565,60 @@ template <typename T> void dlist<T>::insert_head(Node<T> *node)
  * @tparam T The type of data stored in the nodes.
  * @param data The data to be stored in the new node.
  */
-template <typename T> void dlist<T>::insert_tail(T data)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::insert_tail(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Constructs a new element in place at the tail of the doubly linked
+ * list.
+ *
+ * @tparam T The type of data stored in the nodes.
+ * @tparam Args The types of the constructor arguments.
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename... Args>
+T &dlist<T, Alloc, Hooks, Index>::emplace_tail(Args &&...args)
 {
-    insert_tail(Node<T>::create(data, nullptr, nullptr));
+    Node<T> *node = m_alloc.create(std::forward<Args>(args)...);
+    CXC_DLIST_STAT(m_stats.allocations++;)
+    insert_tail(node);
+
+    return node->data;
 }
 
 /**
  * @brief Inserts the given node at the tail of the doubly linked list.
  *
  * This function inserts the given node at the tail of the doubly linked list.
+ * The list takes ownership of the node and destroys it through its allocator,
+ * so the node must come from get_allocator().create(). Objects owned by the
+ * caller belong in an intrusive_dlist instead.
  *
  * @tparam T The type of data stored in the nodes.
  * @param node Pointer to the node to be inserted.
  */
-template <typename T> void dlist<T>::insert_tail(Node<T> *node)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::insert_tail(Node<T> *node)
 {
+    if (is_empty())
+    {
+        insert_head(node);
+        return;
+    }
+
     tail->next = node;
     node->prev = tail;
     node->next = nullptr;
 
     tail = node;
 
-    _events.trigger(Events::INCREASE_COUNT);
+    Hooks::on_increase(m_size);
+    m_index.inserted(m_size - 1, node);
 }
 
 /**
@@ -230,24 +630,42 @@ template <typename T> void dlist<T>::insert_tail(Node<T> *node)
  *
  * @tparam T The type of data stored in the nodes.
  */
-template <typename T> void dlist<T>::clear()
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::clear()
 {
     if (is_empty())
         return;
 
+    // nodes without destructors to run are dropped together with their slabs
+    if constexpr (std::is_trivially_destructible_v<T>)
+    {
+        if (m_alloc.release())
+        {
+            CXC_DLIST_STAT(m_stats.frees += m_size;)
+
+            head = nullptr;
+            tail = nullptr;
+
+            Hooks::on_empty(m_size);
+            m_index.invalidate();
+            return;
+        }
+    }
+
     Node<T> *ptr = head;
 
     while (ptr != nullptr)
     {
         Node<T> *tmp = ptr->next;
-        delete ptr;
+        m_alloc.destroy(ptr);
+        CXC_DLIST_STAT(m_stats.frees++;)
         ptr = tmp;
     }
 
     head = nullptr;
     tail = nullptr;
 
-    _events.trigger(Events::EMPTY_COUNT);
+    Hooks::on_empty(m_size);
+    m_index.invalidate();
 }
 
 /**
@@ -262,15 +680,15 @@ template <typename T> void dlist<T>::clear()
  * @tparam T The type of data stored in the list.
  * @param data The data to be stored in the new node.
  */
-template <typename T> void dlist<T>::insert(T data)
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::insert(T data)
 {
     if (!is_empty())
     {
-        insert_tail(data);
+        insert_tail(std::move(data));
     }
     else
     {
-        insert_head(data);
+        insert_head(std::move(data));
     }
 }
 
@@ -283,29 +701,33 @@ template <typename T> void dlist<T>::insert(T data)
  *
  * @tparam T The type of data stored in the list.
  */
-template <typename T> void dlist<T>::remove_head()
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::remove_head()
 {
     if (is_empty())
         return;
 
     Node<T> *tmp = head;
+    m_index.erased(0, tmp);
 
     if (head->next != nullptr)
     {
         head = tmp->next;
+        head->prev = nullptr;
 
-        delete tmp;
+        m_alloc.destroy(tmp);
+        CXC_DLIST_STAT(m_stats.frees++;)
 
-        _events.trigger(Events::DECREASE_COUNT);
+        Hooks::on_decrease(m_size);
     }
     else
     {
         head = nullptr;
         tail = nullptr;
 
-        delete tmp;
+        m_alloc.destroy(tmp);
+        CXC_DLIST_STAT(m_stats.frees++;)
 
-        _events.trigger(Events::DECREASE_COUNT);
+        Hooks::on_decrease(m_size);
     }
 }
 
@@ -317,7 +739,7 @@ template <typename T> void dlist<T>::remove_head()
  *
  * @tparam T The type of data stored in the list.
  */
-template <typename T> void dlist<T>::remove_tail()
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::remove_tail()
 {
     if (is_empty())
         return;
@@ -330,13 +752,15 @@ template <typename T> void dlist<T>::remove_tail()
     }
 
     Node<T> *tmp = tail;
+    m_index.erased(m_size - 1, tmp);
 
     tail = tmp->prev;
     tail->next = nullptr;
 
-    delete tmp;
+    m_alloc.destroy(tmp);
+    CXC_DLIST_STAT(m_stats.frees++;)
 
-    _events.trigger(Events::DECREASE_COUNT);
+    Hooks::on_decrease(m_size);
 }
 
 /**
@@ -347,7 +771,7 @@ template <typename T> void dlist<T>::remove_tail()
  *
  * @tparam T The type of data stored in the list.
  */
-template <typename T> void dlist<T>::reverse()
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::reverse()
 {
     if (is_empty() || only_element())
         return;
@@ -372,6 +796,117 @@ template <typename T> void dlist<T>::reverse()
     Node<T> *tmp_head = head;
     head = tail;
     tail = tmp_head;
+
+    m_index.invalidate();
+}
+
+/**
+ * @brief Moves the elements into new nodes laid out one after the other in
+ * list order.
+ *
+ * Lists whose nodes were allocated at different times end up scattered over
+ * the heap, and every step of a scan may then miss the cache. After a
+ * relayout a scan reads memory sequentially. With a node_pool of its own the
+ * list moves to a fresh arena and the old one is freed; a pool shared with
+ * other lists keeps its arena, so the old slots stay there for reuse. Order
+ * and size are kept, iterators and references are invalidated.
+ *
+ * If moving an element may throw, elements are copied instead, and the list
+ * is left unchanged when a copy throws.
+ *
+ * An inline_pool is compacted in place instead: its inline slots are already
+ * contiguous, so only elements spilled to the heap are moved, into the slots
+ * freed since, and the other nodes stay where they are. If a copy throws, the
+ * elements moved so far stay moved.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index> void dlist<T, Alloc, Hooks, Index>::relayout()
+{
+    if (m_size == 0)
+        return;
+
+    if constexpr (!std::is_copy_assignable_v<Alloc>)
+    {
+        for (Node<T> *node = head; node != nullptr && m_alloc.has_free_slot();)
+        {
+            Node<T> *next = node->next;
+
+            if (!m_alloc.owns(node))
+            {
+                Node<T> *moved = m_alloc.create(std::move_if_noexcept(node->data));
+
+                unlink(node, node);
+                link_before(next, moved, moved);
+                m_alloc.destroy(node);
+
+                CXC_DLIST_STAT(m_stats.allocations++; m_stats.frees++;)
+            }
+
+            node = next;
+        }
+
+        m_index.invalidate();
+        return;
+    }
+
+    // an allocator of its own is swapped for a fresh one, which frees the old
+    // memory; a shared one, or one that cannot be assigned, is reused
+    bool replace = false;
+
+    if constexpr (std::is_copy_assignable_v<Alloc>)
+        replace = m_alloc.unique();
+
+    Alloc fresh{};
+    Alloc &target = replace ? fresh : m_alloc;
+
+    Node<T> *first = nullptr;
+    Node<T> *last = nullptr;
+
+    try
+    {
+        for (Node<T> *node = head; node != nullptr; node = node->next)
+        {
+            Node<T> *copy = target.create_contiguous(std::move_if_noexcept(node->data));
+            copy->prev = last;
+
+            if (last != nullptr)
+                last->next = copy;
+            else
+                first = copy;
+
+            last = copy;
+        }
+    }
+    catch (...)
+    {
+        while (first != nullptr)
+        {
+            Node<T> *next = first->next;
+            target.destroy(first);
+            first = next;
+        }
+
+        throw;
+    }
+
+    for (Node<T> *node = head; node != nullptr;)
+    {
+        Node<T> *next = node->next;
+        m_alloc.destroy(node);
+        node = next;
+    }
+
+    CXC_DLIST_STAT(m_stats.allocations += m_size; m_stats.frees += m_size;)
+
+    head = first;
+    tail = last;
+
+    if constexpr (std::is_copy_assignable_v<Alloc>)
+    {
+        if (replace)
+            m_alloc = fresh;
+    }
+
+    m_index.invalidate();
 }
 
 /**
@@ -383,7 +918,7 @@ template <typename T> void dlist<T>::reverse()
  * @return A const reference to the data stored in the head node.
  * @throws std::runtime_error if the list is empty.
  */
-template <typename T> const T &dlist<T>::get_head()
+template <typename T, typename Alloc, typename Hooks, typename Index> const T &dlist<T, Alloc, Hooks, Index>::get_head()
 {
     if (is_empty())
         throw std::runtime_error("List is empty, cannot access head data.");
@@ -400,7 +935,7 @@ template <typename T> const T &dlist<T>::get_head()
  * @return A const reference to the data stored in the tail node.
  * @throws std::runtime_error if the list is empty.
  */
-template <typename T> const T &dlist<T>::get_tail()
+template <typename T, typename Alloc, typename Hooks, typename Index> const T &dlist<T, Alloc, Hooks, Index>::get_tail()
 {
     if (is_empty())
         throw std::runtime_error("List is empty, cannot access tail data.");
@@ -414,7 +949,8 @@ template <typename T> const T &dlist<T>::get_tail()
  * @tparam T The type of elements stored in the list.
  * @return The size of the list.
  */
-template <typename T> const size_t &dlist<T>::size()
+template <typename T, typename Alloc, typename Hooks, typename Index>
+const size_t &dlist<T, Alloc, Hooks, Index>::size()
 {
     return m_size;
 }
@@ -425,7 +961,8 @@ template <typename T> const size_t &dlist<T>::size()
  * @param position The position to check.
  * @return true if the position is valid, false otherwise.
  */
-template <typename T> bool dlist<T>::valid_position(size_t position)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+bool dlist<T, Alloc, Hooks, Index>::valid_position(size_t position)
 {
     return position <= m_size - 1;
 }
@@ -437,11 +974,14 @@ template <typename T> bool dlist<T>::valid_position(size_t position)
  * @param position The position of the node to remove.
  * @throws std::runtime_error if the position is invalid or out of bounds.
  */
-template <typename T> void dlist<T>::remove_at(size_t position)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::remove_at(size_t position)
 {
     if (!valid_position(position))
         throw std::runtime_error("[Error] remove_at: position is invalid or out of bounds.");
 
+    CXC_DLIST_STAT(m_stats.positional_ops++;)
+
     if (position == 0)
     {
         remove_head();
@@ -452,17 +992,122 @@ template <typename T> void dlist<T>::remove_at(size_t position)
     }
     else
     {
-        auto prev = std::next(begin(), position - 1);
-        auto current = std::next(begin(), position);
-        auto next = std::next(begin(), position + 1);
+        Node<T> *current = m_index.find(head, tail, m_size, position);
+        m_index.erased(position, current);
+
+        current->prev->next = current->next;
+        current->next->prev = current->prev;
+
+        m_alloc.destroy(current);
+        CXC_DLIST_STAT(m_stats.frees++;)
 
-        prev.get_addr()->next = next.get_addr();
-        next.get_addr()->prev = prev.get_addr();
+        Hooks::on_decrease(m_size);
+    }
+}
+
+/**
+ * @brief Removes the element at the given iterator in O(1).
+ *
+ * Only iterators to the removed element are invalidated. With skip_index the
+ * towers are updated in O(log n) expected steps.
+ *
+ * @param position The element to remove, not end().
+ * @return An iterator to the element following the removed one.
+ * @throws std::runtime_error if position is end().
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+typename dlist<T, Alloc, Hooks, Index>::Iterator dlist<T, Alloc, Hooks, Index>::erase(Iterator position)
+{
+    Node<T> *node = position.get_addr();
+
+    if (node == nullptr)
+        throw std::runtime_error("[Error] erase: cannot erase end().");
+
+    Node<T> *next = node->next;
+
+    m_index.erased(node);
+    unlink(node, node);
+    m_alloc.destroy(node);
+    CXC_DLIST_STAT(m_stats.frees++;)
+
+    Hooks::on_decrease(m_size);
+
+    return iterator_at(next);
+}
+
+/**
+ * @brief Removes the elements [first, last).
+ *
+ * Costs one step per removed element, without any positional lookup.
+ *
+ * @param first The first element to remove.
+ * @param last The element following the last one to remove.
+ * @return last.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+typename dlist<T, Alloc, Hooks, Index>::Iterator dlist<T, Alloc, Hooks, Index>::erase(Iterator first, Iterator last)
+{
+    if (first == last)
+        return last;
 
-        delete current.get_addr();
+    Node<T> *node = first.get_addr();
+    Node<T> *end_node = last.get_addr() != nullptr ? last.get_addr()->prev : tail;
+    size_t count = 0;
 
-        _events.trigger(Events::DECREASE_COUNT);
+    unlink(node, end_node);
+
+    while (node != nullptr)
+    {
+        Node<T> *next = node->next;
+        m_alloc.destroy(node);
+        CXC_DLIST_STAT(m_stats.frees++;)
+        node = next;
+        count++;
     }
+
+    Hooks::on_decrease(m_size, count);
+    m_index.invalidate();
+
+    return last;
+}
+
+/**
+ * @brief Inserts a new element before the given iterator in O(1).
+ *
+ * With skip_index the towers are updated in O(log n) expected steps.
+ *
+ * @param position The element to insert before, end() to append.
+ * @param data The data to be stored in the new node.
+ * @return An iterator to the new element.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+typename dlist<T, Alloc, Hooks, Index>::Iterator dlist<T, Alloc, Hooks, Index>::insert_before(Iterator position, T data)
+{
+    Node<T> *node = m_alloc.create(std::move(data));
+    CXC_DLIST_STAT(m_stats.allocations++;)
+    link_before(position.get_addr(), node, node);
+
+    Hooks::on_increase(m_size);
+    m_index.inserted(node);
+
+    return iterator_at(node);
+}
+
+/**
+ * @brief Inserts a new element after the given iterator in O(1).
+ *
+ * @param position The element to insert after, not end().
+ * @param data The data to be stored in the new node.
+ * @return An iterator to the new element.
+ * @throws std::runtime_error if position is end().
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+typename dlist<T, Alloc, Hooks, Index>::Iterator dlist<T, Alloc, Hooks, Index>::insert_after(Iterator position, T data)
+{
+    if (position.get_addr() == nullptr)
+        throw std::runtime_error("[Error] insert_after: cannot insert after end().");
+
+    return insert_before(iterator_at(position.get_addr()->next), std::move(data));
 }
 
 /**
@@ -473,31 +1118,52 @@ template <typename T> void dlist<T>::remove_at(size_t position)
  * @param data The data to be stored in the new node.
  * @throws std::runtime_error if the position is invalid or out of bounds.
  */
-template <typename T> void dlist<T>::insert_at(size_t position, T data)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::insert_at(size_t position, T data)
 {
     if (!valid_position(position))
         throw std::runtime_error("[Error] insert_at: position is invalid or out of bounds.");
 
+    emplace_at(position, std::move(data));
+}
+
+/**
+ * @brief Constructs a new element in place at the specified position in the
+ * doubly linked list, with the same position rules as insert_at.
+ *
+ * @param position The position at which to insert the new node.
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element.
+ * @throws std::runtime_error if the position is invalid or out of bounds.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename... Args>
+T &dlist<T, Alloc, Hooks, Index>::emplace_at(size_t position, Args &&...args)
+{
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] emplace_at: position is invalid or out of bounds.");
+
+    CXC_DLIST_STAT(m_stats.positional_ops++;)
+
     if (position == 0)
-    {
-        insert_head(data);
-    }
-    else if (position == m_size - 1)
-    {
-        insert_tail(data);
-    }
-    else
-    {
-        auto prev = std::next(begin(), position - 1);
-        auto next = std::next(begin(), position);
+        return emplace_head(std::forward<Args>(args)...);
 
-        Node<T> *new_node = new Node(data, prev.get_addr(), next.get_addr());
+    if (position == m_size - 1)
+        return emplace_tail(std::forward<Args>(args)...);
 
-        prev.get_addr()->next = new_node;
-        next.get_addr()->prev = new_node;
+    Node<T> *next = m_index.find(head, tail, m_size, position);
+    Node<T> *new_node = m_alloc.create(std::forward<Args>(args)...);
+    CXC_DLIST_STAT(m_stats.allocations++;)
 
-        _events.trigger(Events::INCREASE_COUNT);
-    }
+    new_node->prev = next->prev;
+    new_node->next = next;
+    next->prev->next = new_node;
+    next->prev = new_node;
+
+    Hooks::on_increase(m_size);
+    m_index.inserted(position, new_node);
+
+    return new_node->data;
 }
 
 /**
@@ -507,11 +1173,14 @@ template <typename T> void dlist<T>::insert_at(size_t position, T data)
  * @return Node<T>* Pointer to the node at the specified position.
  * @throw std::runtime_error If the position is invalid or out of bounds.
  */
-template <typename T> Node<T> *dlist<T>::get_node(size_t position)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+Node<T> *dlist<T, Alloc, Hooks, Index>::get_node(size_t position)
 {
     if (!valid_position(position))
         throw std::runtime_error("[Error] get: position is invalid or out of bounds.");
 
+    CXC_DLIST_STAT(m_stats.positional_ops++;)
+
     if (position == 0)
     {
         return head;
@@ -522,8 +1191,7 @@ template <typename T> Node<T> *dlist<T>::get_node(size_t position)
     }
     else
     {
-        auto it = std::next(begin(), position);
-        return it.get_addr();
+        return m_index.find(head, tail, m_size, position);
     }
 }
 
@@ -534,16 +1202,789 @@ template <typename T> Node<T> *dlist<T>::get_node(size_t position)
  * @param data The new data for the node.
  * @throw std::runtime_error If the position is invalid or out of bounds.
  */
-template <typename T> void dlist<T>::change(size_t position, T data)
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::change(size_t position, T data)
 {
-    if (!valid_position(position))
+    if (!valid_position(position) || is_empty())
         throw std::runtime_error("[Error] change: position is invalid or out of bounds");
 
-    auto it = std::next(begin(), position);
+    CXC_DLIST_STAT(m_stats.positional_ops++;)
+
+    m_index.find(head, tail, m_size, position)->data = std::move(data);
+}
+
+/**
+ * @brief Detaches the chain of nodes [first, last] from the list, without
+ * touching the size.
+ *
+ * @param first The first node of the chain.
+ * @param last The last node of the chain.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::unlink(Node<T> *first, Node<T> *last)
+{
+    if (first->prev != nullptr)
+        first->prev->next = last->next;
+    else
+        head = last->next;
+
+    if (last->next != nullptr)
+        last->next->prev = first->prev;
+    else
+        tail = first->prev;
+
+    first->prev = nullptr;
+    last->next = nullptr;
+}
+
+/**
+ * @brief Links the chain of nodes [first, last] before a node of the list,
+ * without touching the size.
+ *
+ * @param position The node to link before, nullptr to append at the tail.
+ * @param first The first node of the chain.
+ * @param last The last node of the chain.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::link_before(Node<T> *position, Node<T> *first, Node<T> *last)
+{
+    Node<T> *prev = position != nullptr ? position->prev : tail;
+
+    first->prev = prev;
+    last->next = position;
+
+    if (prev != nullptr)
+        prev->next = first;
+    else
+        head = first;
+
+    if (position != nullptr)
+        position->prev = last;
+    else
+        tail = last;
+}
+
+/**
+ * @brief Moves the chain of nodes [first, last] of another list before a node
+ * of this list.
+ *
+ * The nodes are relinked in O(1) when both lists' allocators are equal, that
+ * is when the lists were built to share one (see the std::allocator_arg
+ * constructor). Otherwise each element is moved into a node of this list's
+ * allocator, so that a list never starts sharing an allocator on its own.
+ *
+ * @param position The node to link before, nullptr to append at the tail.
+ * @param other The list the chain belongs to.
+ * @param first The first node of the chain.
+ * @param last The last node of the chain.
+ * @param count The number of nodes in the chain.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::transfer(Node<T> *position, dlist &other, Node<T> *first, Node<T> *last,
+                                             size_t count)
+{
+    other.m_index.invalidate();
+    m_index.invalidate();
+
+    if (m_alloc == other.m_alloc)
+    {
+        other.unlink(first, last);
+        other.Hooks::on_decrease(other.m_size, count);
+
+        link_before(position, first, last);
+        Hooks::on_increase(m_size, count);
+        return;
+    }
+
+    Node<T> *stop = last->next;
+
+    for (Node<T> *node = first; node != stop;)
+    {
+        Node<T> *next = node->next;
+        Node<T> *moved = m_alloc.create(std::move(node->data));
+        CXC_DLIST_STAT(m_stats.allocations++;)
+
+        other.unlink(node, node);
+        other.m_alloc.destroy(node);
+        CXC_DLIST_STAT(other.m_stats.frees++;)
+        other.Hooks::on_decrease(other.m_size);
+
+        link_before(position, moved, moved);
+        Hooks::on_increase(m_size);
+
+        node = next;
+    }
+}
+
+/**
+ * @brief Moves every element of another list before the given position.
+ *
+ * O(1) when both lists share their allocator (see transfer). Two lists built
+ * with their own default node_pool do not: every element is then moved into
+ * a new node, in O(n) allocations, and its iterators are invalidated. The
+ * other list is left empty.
+ *
+ * @param position The element to insert before, end() to append.
+ * @param other The list to take the elements from.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::splice(Iterator position, dlist &other)
+{
+    if (&other == this || other.is_empty())
+        return;
+
+    transfer(position.get_addr(), other, other.head, other.tail, other.m_size);
+}
+
+/**
+ * @brief Moves a single element of a list, possibly this one, before the
+ * given position.
+ *
+ * Relinked in O(1) within a list or between lists sharing their allocator,
+ * otherwise moved into a new node (see transfer). Within a list, skip_index
+ * towers are updated in O(log n) expected steps.
+ *
+ * @param position The element to insert before, end() to append.
+ * @param other The list the element belongs to.
+ * @param it The element to move.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::splice(Iterator position, dlist &other, Iterator it)
+{
+    Node<T> *node = it.get_addr();
+
+    if (&other != this)
+    {
+        transfer(position.get_addr(), other, node, node, 1);
+        return;
+    }
+
+    if (position.get_addr() == node || position.get_addr() == node->next)
+        return;
+
+    m_index.erased(node);
+    unlink(node, node);
+    link_before(position.get_addr(), node, node);
+
+    m_index.inserted(node);
+}
+
+/**
+ * @brief Moves the elements [first, last) of a list, possibly this one,
+ * before the given position.
+ *
+ * Relinking is O(1) within a list or between lists sharing their allocator;
+ * moving the range out of another list also counts its elements. Between
+ * lists with different allocators, each element is moved into a new node
+ * (see transfer). The position must not lie inside the range.
+ *
+ * @param position The element to insert before, end() to append.
+ * @param other The list the elements belong to.
+ * @param first The first element to move.
+ * @param last The element following the last one to move.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::splice(Iterator position, dlist &other, Iterator first, Iterator last)
+{
+    if (first == last)
+        return;
+
+    Node<T> *begin_node = first.get_addr();
+    Node<T> *end_node = last.get_addr() != nullptr ? last.get_addr()->prev : other.tail;
+
+    if (&other != this)
+    {
+        size_t count = 1;
+
+        for (Node<T> *node = begin_node; node != end_node; node = node->next)
+            count++;
+
+        transfer(position.get_addr(), other, begin_node, end_node, count);
+        return;
+    }
+
+    if (position.get_addr() == last.get_addr())
+        return;
+
+    unlink(begin_node, end_node);
+    link_before(position.get_addr(), begin_node, end_node);
+
+    m_index.invalidate();
+}
+
+/**
+ * @brief Merges another list sorted by cmp into this list sorted by cmp.
+ *
+ * The other list is spliced at the tail and both runs are merged by relinking
+ * nodes. The splice relinks the other list's nodes only when both lists
+ * share their allocator; otherwise its elements are first moved into new
+ * nodes, one allocation each (see transfer). The merge is stable: equal
+ * elements of this list stay before those of the other list.
+ *
+ * @tparam Compare The type of the comparison function.
+ * @param other The list to merge, left empty.
+ * @param cmp Returns true if its first argument is ordered before its second.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Compare>
+void dlist<T, Alloc, Hooks, Index>::merge(dlist &other, Compare cmp)
+{
+    if (&other == this || other.is_empty())
+        return;
+
+    Node<T> *last_own = tail;
+
+    splice(end(), other);
+
+    if (last_own == nullptr)
+        return;
+
+    Node<T> *own = head;
+    Node<T> *theirs = last_own->next;
+
+    while (own != theirs && theirs != nullptr)
+    {
+        if (cmp(theirs->data, own->data))
+        {
+            Node<T> *next = theirs->next;
+
+            unlink(theirs, theirs);
+            link_before(own, theirs, theirs);
+
+            theirs = next;
+        }
+        else
+        {
+            own = own->next;
+        }
+    }
+
+    m_index.invalidate();
+}
+
+/**
+ * @brief Inserts copies of the elements [first, last) before the given
+ * position.
+ *
+ * The new nodes are chained together first and linked into the list at once,
+ * and the size is updated a single time.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param position The element to insert before, end() to append.
+ * @param first The first element to insert.
+ * @param last The element following the last one to insert.
+ * @return An iterator to the first inserted element, or position if the range
+ * is empty.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename InputIt>
+typename dlist<T, Alloc, Hooks, Index>::Iterator dlist<T, Alloc, Hooks, Index>::insert_range(Iterator position,
+                                                                                              InputIt first,
+                                                                                              InputIt last)
+{
+    Node<T> *chain_head = nullptr;
+    Node<T> *chain_tail = nullptr;
+    size_t count = 0;
+
+    try
+    {
+        for (; first != last; ++first)
+        {
+            Node<T> *node = m_alloc.create(*first);
+            CXC_DLIST_STAT(m_stats.allocations++;)
+            node->prev = chain_tail;
+
+            if (chain_tail != nullptr)
+                chain_tail->next = node;
+            else
+                chain_head = node;
+
+            chain_tail = node;
+            count++;
+        }
+    }
+    catch (...)
+    {
+        while (chain_head != nullptr)
+        {
+            Node<T> *next = chain_head->next;
+            m_alloc.destroy(chain_head);
+            CXC_DLIST_STAT(m_stats.frees++;)
+            chain_head = next;
+        }
+
+        throw;
+    }
+
+    if (count == 0)
+        return position;
+
+    link_before(position.get_addr(), chain_head, chain_tail);
+
+    Hooks::on_increase(m_size, count);
+    m_index.invalidate();
+
+    return iterator_at(chain_head);
+}
+
+/**
+ * @brief Appends copies of the elements [first, last) at the tail of the list.
+ *
+ * @tparam InputIt The type of the input iterators.
+ * @param first The first element to append.
+ * @param last The element following the last one to append.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename InputIt>
+void dlist<T, Alloc, Hooks, Index>::append_range(InputIt first, InputIt last)
+{
+    insert_range(end(), first, last);
+}
+
+/**
+ * @brief Rebuilds the prev pointers, head and tail from a chain of nodes
+ * linked through next only.
+ *
+ * @param first The first node of the chain, nullptr for an empty list.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+void dlist<T, Alloc, Hooks, Index>::relink(Node<T> *first)
+{
+    head = first;
+    tail = nullptr;
+
+    for (Node<T> *node = first; node != nullptr; node = node->next)
+    {
+        node->prev = tail;
+        tail = node;
+    }
+}
+
+/**
+ * @brief Appends a chain of nodes linked through next to another one.
+ *
+ * @param first The first chain, may be nullptr.
+ * @param second The chain to append, may be nullptr.
+ * @return The concatenated chain.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+Node<T> *dlist<T, Alloc, Hooks, Index>::concat_chains(Node<T> *first, Node<T> *second)
+{
+    if (first == nullptr)
+        return second;
+
+    Node<T> *last = first;
+
+    while (last->next != nullptr)
+        last = last->next;
+
+    last->next = second;
+    return first;
+}
+
+/**
+ * @brief Merges two sorted chains of nodes linked through next.
+ *
+ * Ties are taken from the first chain, which keeps the merge stable. If cmp
+ * throws, every node is left in first (in unspecified order), second is set
+ * to nullptr and the exception is rethrown.
+ *
+ * @tparam Compare The type of the comparison function.
+ * @param first The chain holding the earlier elements.
+ * @param second The chain holding the later elements.
+ * @param cmp Returns true if its first argument is ordered before its second.
+ * @return The merged chain.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Compare>
+Node<T> *dlist<T, Alloc, Hooks, Index>::merge_chains(Node<T> *&first, Node<T> *&second, Compare &cmp)
+{
+    Node<T> *merged = nullptr;
+    Node<T> **link = &merged;
+
+    try
+    {
+        while (first != nullptr && second != nullptr)
+        {
+            Node<T> *&from = cmp(second->data, first->data) ? second : first;
+
+            *link = from;
+            link = &from->next;
+            from = from->next;
+        }
+    }
+    catch (...)
+    {
+        *link = concat_chains(first, second);
+        first = merged;
+        second = nullptr;
+        throw;
+    }
+
+    *link = first != nullptr ? first : second;
+
+    first = nullptr;
+    second = nullptr;
+
+    return merged;
+}
+
+/**
+ * @brief Sorts a chain of nodes linked through next with a bottom-up merge
+ * sort, relinking nodes without allocating or moving any element.
+ *
+ * Bin i holds a sorted run of 2^i nodes; every node from the input is merged
+ * into the bins like a binary counter, and the bins are merged together at
+ * the end. If cmp throws, chain holds every node in unspecified order.
+ *
+ * @tparam Compare The type of the comparison function.
+ * @param chain The chain to sort, replaced by the sorted chain.
+ * @param cmp Returns true if its first argument is ordered before its second.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Compare>
+void dlist<T, Alloc, Hooks, Index>::sort_chain(Node<T> *&chain, Compare &cmp)
+{
+    Node<T> *bins[64] = {};
+    Node<T> *carry = nullptr;
+
+    try
+    {
+        while (chain != nullptr)
+        {
+            carry = chain;
+            chain = chain->next;
+            carry->next = nullptr;
+
+            size_t i = 0;
+
+            for (; bins[i] != nullptr; i++)
+                carry = merge_chains(bins[i], carry, cmp);
+
+            bins[i] = carry;
+            carry = nullptr;
+        }
+
+        for (size_t i = 0; i < 64; i++)
+        {
+            if (bins[i] != nullptr)
+                carry = merge_chains(bins[i], carry, cmp);
+        }
+
+        chain = carry;
+    }
+    catch (...)
+    {
+        chain = concat_chains(carry, chain);
+
+        for (size_t i = 0; i < 64; i++)
+            chain = concat_chains(bins[i], chain);
+
+        throw;
+    }
+}
+
+/**
+ * @brief Sorts the list with a stable merge sort that relinks the existing
+ * nodes, without allocating or copying any element.
+ *
+ * If cmp throws, every element is kept but their order is unspecified.
+ *
+ * @tparam Compare The type of the comparison function.
+ * @param cmp Returns true if its first argument is ordered before its second.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Compare>
+void dlist<T, Alloc, Hooks, Index>::sort(Compare cmp)
+{
+    if (is_empty() || only_element())
+        return;
+
+    Node<T> *chain = head;
+    m_index.invalidate();
+
+    try
+    {
+        sort_chain(chain, cmp);
+    }
+    catch (...)
+    {
+        relink(chain);
+        throw;
+    }
+
+    relink(chain);
+}
+
+/**
+ * @brief Sorts the list on several threads.
+ *
+ * The list is cut into one run per hardware thread, runs are sorted
+ * concurrently with the same merge sort as sort(cmp), then merged pairwise,
+ * each round of merges running concurrently too. The result is stable. Short
+ * lists and single-core machines fall back to sort(cmp).
+ *
+ * The comparison function is copied to each thread and called concurrently.
+ * If it throws, every element is kept in unspecified order and the first
+ * exception is rethrown.
+ *
+ * @tparam Compare The type of the comparison function.
+ * @param cmp Returns true if its first argument is ordered before its second.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Compare>
+void dlist<T, Alloc, Hooks, Index>::sort(parallel_t, Compare cmp)
+{
+    // below this many nodes per thread, starting threads costs more than it saves
+    constexpr size_t min_run = 1 << 14;
+
+    size_t workers = std::thread::hardware_concurrency();
+
+    if (workers > m_size / min_run)
+        workers = m_size / min_run;
+
+    if (workers < 2)
+    {
+        sort(cmp);
+        return;
+    }
+
+    m_index.invalidate();
+
+    // cut the list into runs of equal length
+    std::vector<Node<T> *> runs(workers);
+    Node<T> *node = head;
+
+    for (size_t w = 0; w < workers; w++)
+    {
+        size_t length = w + 1 < workers ? m_size / workers : m_size - (workers - 1) * (m_size / workers);
+
+        runs[w] = node;
+
+        for (size_t i = 1; i < length; i++)
+            node = node->next;
+
+        Node<T> *next = node->next;
+        node->next = nullptr;
+        node = next;
+    }
+
+    std::exception_ptr error;
+
+    auto run_all = [&error](size_t count, auto &&task) {
+        std::vector<std::exception_ptr> errors(count);
+        std::vector<std::thread> threads;
+
+        for (size_t i = 1; i < count; i++)
+            threads.emplace_back([&, i]() { task(i, errors[i]); });
+
+        task(0, errors[0]);
+
+        for (std::thread &thread : threads)
+            thread.join();
+
+        for (std::exception_ptr &e : errors)
+        {
+            if (e && !error)
+                error = e;
+        }
+    };
+
+    run_all(workers, [&runs, &cmp](size_t i, std::exception_ptr &e) {
+        Compare local = cmp;
+
+        try
+        {
+            sort_chain(runs[i], local);
+        }
+        catch (...)
+        {
+            e = std::current_exception();
+        }
+    });
+
+    // merge neighbouring runs until one is left, the earlier run on the left
+    while (!error && runs.size() > 1)
+    {
+        std::vector<Node<T> *> merged((runs.size() + 1) / 2);
+
+        run_all(runs.size() / 2, [&runs, &merged, &cmp](size_t i, std::exception_ptr &e) {
+            Compare local = cmp;
+
+            try
+            {
+                merged[i] = merge_chains(runs[2 * i], runs[2 * i + 1], local);
+            }
+            catch (...)
+            {
+                merged[i] = runs[2 * i];
+                e = std::current_exception();
+            }
+        });
+
+        if (runs.size() % 2 == 1)
+            merged.back() = runs.back();
+
+        runs.swap(merged);
+    }
+
+    Node<T> *chain = nullptr;
+
+    for (size_t i = runs.size(); i-- > 0;)
+        chain = concat_chains(runs[i], chain);
+
+    relink(chain);
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * @brief Cuts the list into segments of about equal length and calls fn on
+ * each of them as a task of a pool.
+ *
+ * The segment heads are found by one walk over the list, or by lookups in
+ * the skip_index when the list keeps one. There are a few segments per
+ * thread so that threads done early steal the remaining ones. Short lists,
+ * and pools without workers, are handled as one segment on the calling
+ * thread.
+ *
+ * @tparam Fn The type of the function.
+ * @param pool The pool running the segments.
+ * @param fn Called as fn(segment, first node, length), concurrently.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Fn>
+void dlist<T, Alloc, Hooks, Index>::par_segments(work_stealing_pool &pool, Fn &&fn)
+{
+    // below this many nodes per segment, a task costs more than it saves
+    constexpr size_t min_segment = 1 << 12;
+
+    size_t segments = (pool.size() + 1) * 4;
+
+    if (segments > m_size / min_segment)
+        segments = m_size / min_segment;
+
+    if (pool.size() == 0 || segments < 2)
+    {
+        if (m_size != 0)
+            fn(0, head, m_size);
+
+        return;
+    }
+
+    auto first_of = [this, segments](size_t segment) { return segment * m_size / segments; };
+
+    std::vector<Node<T> *> starts(segments);
+
+    if constexpr (std::is_same_v<Index, skip_index<T>>)
+    {
+        for (size_t s = 0; s < segments; s++)
+            starts[s] = m_index.find(head, tail, m_size, first_of(s));
+    }
+    else
+    {
+        Node<T> *node = head;
+
+        for (size_t s = 0; s < segments; s++)
+        {
+            starts[s] = node;
+
+            for (size_t i = first_of(s); i < first_of(s + 1); i++)
+                node = node->next;
+        }
+    }
+
+    auto task = [&](size_t s) { fn(s, starts[s], first_of(s + 1) - first_of(s)); };
+    pool.run(segments, task);
+}
+
+/**
+ * @brief Calls a function on every element, with the list split across the
+ * threads of a pool.
+ *
+ * If calls throw, the remaining segments still run and the first exception
+ * is rethrown.
+ *
+ * @tparam Fn The type of the function.
+ * @param fn Called with a reference to each element, concurrently from
+ * several threads and in no particular order.
+ * @param pool The pool to run on, the process-wide one by default.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Fn>
+void dlist<T, Alloc, Hooks, Index>::par_for_each(Fn fn, work_stealing_pool &pool)
+{
+    par_segments(pool, [&fn](size_t, Node<T> *node, size_t length) {
+        for (size_t i = 0; i < length; i++, node = node->next)
+            fn(node->data);
+    });
+}
+
+/**
+ * @brief Replaces every element with the result of a function, with the
+ * list split across the threads of a pool.
+ *
+ * If calls throw, the remaining segments still run and the first exception
+ * is rethrown; the elements are then partly transformed.
+ *
+ * @tparam Fn The type of the function.
+ * @param fn Called with each element, returns its new value; called
+ * concurrently from several threads and in no particular order.
+ * @param pool The pool to run on, the process-wide one by default.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename Fn>
+void dlist<T, Alloc, Hooks, Index>::par_transform(Fn fn, work_stealing_pool &pool)
+{
+    par_segments(pool, [&fn](size_t, Node<T> *node, size_t length) {
+        for (size_t i = 0; i < length; i++, node = node->next)
+            node->data = fn(node->data);
+    });
+}
+
+/**
+ * @brief Folds the elements with an associative operation, with the list
+ * split across the threads of a pool.
+ *
+ * Each segment is folded from its first element, then the results are
+ * folded into init in list order, so op needs to be associative but not
+ * commutative.
+ *
+ * @tparam R The type of the result, constructible from T.
+ * @tparam Op The type of the operation.
+ * @param init The initial value, returned for an empty list.
+ * @param op Combines two values of type R, or an R and an element.
+ * @param pool The pool to run on, the process-wide one by default.
+ * @return The folded value.
+ */
+template <typename T, typename Alloc, typename Hooks, typename Index>
+template <typename R, typename Op>
+R dlist<T, Alloc, Hooks, Index>::par_reduce(R init, Op op, work_stealing_pool &pool)
+{
+    std::vector<std::optional<R>> partial((pool.size() + 1) * 4);
+
+    par_segments(pool, [&op, &partial](size_t segment, Node<T> *node, size_t length) {
+        R value(node->data);
+
+        for (size_t i = 1; i < length; i++)
+        {
+            node = node->next;
+            value = op(std::move(value), node->data);
+        }
+
+        partial[segment] = std::move(value);
+    });
+
+    for (std::optional<R> &value : partial)
+    {
+        if (value)
+            init = op(std::move(init), std::move(*value));
+    }
 
-    it.get_addr()->data = data;
+    return init;
 }
 
 } // namespace cxc
 
-#endif
\ No newline at end of file
+#endif
@@ -1,45 +1,113 @@
 #ifndef CXC_DLIST_H
 #define CXC_DLIST_H
 
-#include "events.h"
+#include "codec.h"
+#include "hooks.h"
+#include "index.h"
 #include "node.h"
+#include "pool.h"
+#include "stats.h"
+#include "thread_pool.h"
 
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 
 namespace cxc
 {
 
-enum class Events
+/**
+ * @brief Tag selecting the multi-threaded overload of an algorithm, as in
+ * list.sort(cxc::par).
+ *
+ * A library tag rather than std::execution::par, whose header pulls the
+ * standard library's parallel backend (TBB with libstdc++) into every user
+ * of dlist.h.
+ */
+struct parallel_t
 {
-    INCREASE_COUNT,
-    DECREASE_COUNT,
-    EMPTY_COUNT
+    explicit parallel_t() = default;
 };
 
-template <typename T> struct dlist
+inline constexpr parallel_t par{};
+
+/**
+ * @brief Doubly linked list.
+ *
+ * Iterators and references to an element stay valid until that element is
+ * removed (erase, remove_head / remove_tail / remove_at, clear): insertions,
+ * sort, reverse and merge only relink nodes. Splicing between lists sharing
+ * their allocator keeps them valid too, now pointing into the destination
+ * list; otherwise the spliced elements are moved into new nodes and their
+ * iterators are invalidated. end() is never invalidated.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam Alloc The node allocator policy, node_pool<T> or heap_allocator<T>.
+ * @tparam Hooks The mutation hooks, size_hooks or event_hooks. Only their public
+ * members, such as event_hooks::_events, are reachable through the list.
+ * @tparam Index The positional index, linear_index<T> or skip_index<T>.
+ */
+template <typename T, typename Alloc = node_pool<T>, typename Hooks = size_hooks, typename Index = linear_index<T>>
+struct dlist : public Hooks
 {
+  public:
+    struct Iterator;
+    struct ConstIterator;
+    struct Reversed;
+
   private:
     size_t m_size = 0;
     Node<T> *head = nullptr;
     Node<T> *tail = nullptr;
+    [[no_unique_address]] Alloc m_alloc{};
+    [[no_unique_address]] Index m_index{};
+    // mutable so that iterating a const list still counts its steps
+    CXC_DLIST_STAT(mutable dlist_counters m_stats{};)
 
-    template <typename... Args> void init(T first, Args... rest);
+    template <typename First, typename... Rest> void init(First &&first, Rest &&...rest);
 
     void init();
 
-    void empty();
+    static Alloc moved_allocator(Alloc &other);
 
-    void increase();
+    void steal(dlist &other);
 
-    void decrease();
-
-    void init_events();
+    void take(dlist &other);
 
     bool valid_position(size_t position);
 
+    Iterator iterator_at(Node<T> *node);
+
+    ConstIterator iterator_at(const Node<T> *node) const;
+
+    void unlink(Node<T> *first, Node<T> *last);
+
+    void link_before(Node<T> *position, Node<T> *first, Node<T> *last);
+
+    void transfer(Node<T> *position, dlist &other, Node<T> *first, Node<T> *last, size_t count);
+
+    void relink(Node<T> *first);
+
+    static Node<T> *concat_chains(Node<T> *first, Node<T> *second);
+
+    template <typename Compare> static Node<T> *merge_chains(Node<T> *&first, Node<T> *&second, Compare &cmp);
+
+    template <typename Compare> static void sort_chain(Node<T> *&chain, Compare &cmp);
+
+    template <typename Fn> void par_segments(work_stealing_pool &pool, Fn &&fn);
+
   public:
-    cxc::EventListener<Events> _events{};
-    template <typename... Args> dlist(Args... args);
+    template <typename... Args> dlist(Args &&...args);
+    dlist(std::allocator_arg_t, Alloc alloc);
+    dlist(const dlist &) = delete;
+    dlist(dlist &&other) noexcept(std::is_nothrow_move_constructible_v<Alloc>);
+    dlist &operator=(const dlist &) = delete;
+    dlist &operator=(dlist &&other) noexcept(std::is_nothrow_move_assignable_v<Alloc>);
+    ~dlist();
+
+    Alloc &get_allocator();
 
     //  inseration / deletion
     void insert_head(T data);
@@ -50,11 +118,28 @@ template <typename T> struct dlist
 
     void insert(T data);
     void insert_at(size_t position, T data);
+    Iterator insert_before(Iterator position, T data);
+    Iterator insert_after(Iterator position, T data);
+
+    template <typename... Args> T &emplace_head(Args &&...args);
+    template <typename... Args> T &emplace_tail(Args &&...args);
+    template <typename... Args> T &emplace_at(size_t position, Args &&...args);
 
     void clear();
     void remove_head();
     void remove_tail();
     void remove_at(size_t position);
+    Iterator erase(Iterator position);
+    Iterator erase(Iterator first, Iterator last);
+
+    // splicing / bulk insertion
+    void splice(Iterator position, dlist &other);
+    void splice(Iterator position, dlist &other, Iterator it);
+    void splice(Iterator position, dlist &other, Iterator first, Iterator last);
+    template <typename Compare = std::less<>> void merge(dlist &other, Compare cmp = Compare{});
+
+    template <typename InputIt> Iterator insert_range(Iterator position, InputIt first, InputIt last);
+    template <typename InputIt> void append_range(InputIt first, InputIt last);
 
     // modify
     void change(size_t position, T data);
@@ -68,9 +153,29 @@ template <typename T> struct dlist
 
     // search
 
+    // sorting
+    template <typename Compare = std::less<>> void sort(Compare cmp = Compare{});
+    template <typename Compare = std::less<>>
+    void sort(parallel_t policy, Compare cmp = Compare{});
+
+    // parallel algorithms
+    template <typename Fn> void par_for_each(Fn fn, work_stealing_pool &pool = work_stealing_pool::instance());
+    template <typename Fn> void par_transform(Fn fn, work_stealing_pool &pool = work_stealing_pool::instance());
+    template <typename R, typename Op = std::plus<>>
+    R par_reduce(R init, Op op = Op{}, work_stealing_pool &pool = work_stealing_pool::instance());
+
+    // serialization
+    template <typename Codec = codec<T>> void save(std::ostream &out, Codec element_codec = Codec{});
+    template <typename Codec = codec<T>> void load(std::istream &in, Codec element_codec = Codec{});
+
+    // statistics
+    dlist_stats stats();
+    void reset_stats();
+
     // misc
     void print();
     void reverse();
+    void relayout();
     bool only_element();
 
     /**
@@ -78,7 +183,10 @@ template <typename T> struct dlist
      *
      * This class provides an iterator for traversing a doubly linked list.
      * It can be used with both STL and custom functions to iterate over the
-     * elements of the list.
+     * elements of the list, and models std::bidirectional_iterator, so that
+     * the list is a std::ranges::bidirectional_range and std::views adaptors
+     * (reverse, filter, transform, take...) walk it lazily. Iterators made by
+     * the list know its tail, which is where end() goes when decremented.
      *
      * @tparam T The type of elements stored in the doubly linked list.
      */
@@ -93,42 +201,64 @@ template <typename T> struct dlist
         using iterator_category = std::bidirectional_iterator_tag;
 
       private:
-        Node<T> *current;
+        Node<T> *current = nullptr;
+        // the owning list's tail, for decrementing end()
+        Node<T> *const *last = nullptr;
+        // the owning list's step counter, with CXC_DLIST_STATS
+        CXC_DLIST_STAT(size_t *steps = nullptr;)
+
+        friend struct ConstIterator;
 
       public:
+        Iterator() = default;
+
         Iterator(Node<T> *ptr) : current(ptr)
         {
         }
 
+        Iterator(Node<T> *ptr, Node<T> *const *_last) : current(ptr), last(_last)
+        {
+        }
+
+        CXC_DLIST_STAT(Iterator(Node<T> *ptr, Node<T> *const *_last, size_t *_steps)
+                       : current(ptr), last(_last), steps(_steps){})
+
         // operator definitions for STL algorithms to work.
         T &operator*() const
         {
             return current->data;
         }
 
+        T *operator->() const
+        {
+            return &current->data;
+        }
+
         Iterator &operator++()
         {
+            CXC_DLIST_STAT(if (steps != nullptr)(*steps)++;)
             current = current->next;
             return *this;
         }
 
         Iterator &operator--()
         {
-            current = current->prev;
+            CXC_DLIST_STAT(if (steps != nullptr)(*steps)++;)
+            current = current != nullptr ? current->prev : *last;
             return *this;
         }
 
         Iterator operator++(int)
         {
             Iterator tmp = *this;
-            current = current->next;
+            ++*this;
             return tmp;
         }
 
         Iterator operator--(int)
         {
             Iterator tmp = *this;
-            current = current->prev;
+            --*this;
             return tmp;
         }
 
@@ -152,6 +282,224 @@ template <typename T> struct dlist
         }
     };
 
+    /**
+     * @brief Iterator over the elements of a const list, read-only.
+     *
+     * Same as Iterator otherwise, which converts to it.
+     */
+    struct ConstIterator
+    {
+        using pointer = const T *;
+        using value_type = T;
+        using reference = const T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+      private:
+        const Node<T> *current = nullptr;
+        // the owning list's tail, for decrementing end()
+        Node<T> *const *last = nullptr;
+        // the owning list's step counter, with CXC_DLIST_STATS
+        CXC_DLIST_STAT(size_t *steps = nullptr;)
+
+      public:
+        ConstIterator() = default;
+
+        ConstIterator(const Node<T> *ptr, Node<T> *const *_last) : current(ptr), last(_last)
+        {
+        }
+
+        CXC_DLIST_STAT(ConstIterator(const Node<T> *ptr, Node<T> *const *_last, size_t *_steps)
+                       : current(ptr), last(_last), steps(_steps){})
+
+        ConstIterator(const Iterator &it) : current(it.current), last(it.last) CXC_DLIST_STAT(, steps(it.steps))
+        {
+        }
+
+        const T &operator*() const
+        {
+            return current->data;
+        }
+
+        const T *operator->() const
+        {
+            return &current->data;
+        }
+
+        ConstIterator &operator++()
+        {
+            CXC_DLIST_STAT(if (steps != nullptr)(*steps)++;)
+            current = current->next;
+            return *this;
+        }
+
+        ConstIterator &operator--()
+        {
+            CXC_DLIST_STAT(if (steps != nullptr)(*steps)++;)
+            current = current != nullptr ? current->prev : *last;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        ConstIterator operator--(int)
+        {
+            ConstIterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator &other) const
+        {
+            return current == other.current;
+        }
+
+        bool operator!=(const ConstIterator &other) const
+        {
+            return current != other.current;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<Iterator>;
+    using const_reverse_iterator = std::reverse_iterator<ConstIterator>;
+
+    /**
+     * @brief The list seen from tail to head, as returned by reversed().
+     *
+     * Holds no copy of the list: it is a pair of reverse iterators, valid as
+     * long as the list is. Iterating it goes through prev links, and a
+     * reversed() of it gives the list in its own order again.
+     */
+    struct Reversed
+    {
+        dlist *list;
+
+        reverse_iterator begin() const
+        {
+            return list->rbegin();
+        }
+
+        reverse_iterator end() const
+        {
+            return list->rend();
+        }
+
+        dlist &reversed() const
+        {
+            return *list;
+        }
+    };
+
+    /**
+     * @brief Forward iterator prefetching the node a fixed distance ahead of
+     * the current one.
+     *
+     * A second pointer walks the list ahead of the iterator, so the nodes
+     * the iterator reaches are already on their way to the cache while the
+     * current element is processed. It helps when the work per element hides
+     * the memory latency of a fragmented list; after relayout() the hardware
+     * prefetcher does the same for free.
+     */
+    struct PrefetchIterator
+    {
+        using pointer = T *;
+        using value_type = T;
+        using reference = T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+      private:
+        Node<T> *current = nullptr;
+        Node<T> *ahead = nullptr;
+
+      public:
+        PrefetchIterator() = default;
+
+        PrefetchIterator(Node<T> *ptr, size_t distance) : current(ptr), ahead(ptr)
+        {
+            for (size_t i = 0; i < distance && ahead != nullptr; i++)
+            {
+                ahead = ahead->next;
+
+                if (ahead != nullptr)
+                    prefetch(ahead);
+            }
+        }
+
+        T &operator*() const
+        {
+            return current->data;
+        }
+
+        PrefetchIterator &operator++()
+        {
+            current = current->next;
+
+            if (ahead != nullptr)
+            {
+                ahead = ahead->next;
+
+                if (ahead != nullptr)
+                    prefetch(ahead);
+            }
+
+            return *this;
+        }
+
+        PrefetchIterator operator++(int)
+        {
+            PrefetchIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const PrefetchIterator &other) const
+        {
+            return current == other.current;
+        }
+
+        bool operator!=(const PrefetchIterator &other) const
+        {
+            return current != other.current;
+        }
+    };
+
+    /**
+     * @brief Range over the list with PrefetchIterator, as returned by
+     * prefetched().
+     */
+    struct Prefetched
+    {
+        PrefetchIterator first;
+
+        PrefetchIterator begin() const
+        {
+            return first;
+        }
+
+        PrefetchIterator end() const
+        {
+            return PrefetchIterator();
+        }
+    };
+
+    /**
+     * @brief Returns the elements as a range whose iterators prefetch nodes
+     * ahead, for use in range-for loops and std algorithms.
+     *
+     * @param distance How many nodes ahead of the current one to prefetch.
+     * @return The range.
+     */
+    Prefetched prefetched(size_t distance = 8)
+    {
+        return Prefetched{PrefetchIterator(head, distance)};
+    }
+
     /**
      * @brief Returns an iterator pointing to the first element in the list.
      *
@@ -159,7 +507,7 @@ template <typename T> struct dlist
      */
     Iterator begin()
     {
-        return Iterator(head);
+        return iterator_at(head);
     }
 
     /**
@@ -170,10 +518,118 @@ template <typename T> struct dlist
      */
     Iterator end()
     {
-        return Iterator(nullptr);
+        return iterator_at(nullptr);
+    }
+
+    /**
+     * @brief Returns a read-only iterator to the first element.
+     *
+     * @return A const iterator to the first element.
+     */
+    ConstIterator begin() const
+    {
+        return iterator_at(head);
+    }
+
+    /**
+     * @brief Returns the read-only past-the-end iterator.
+     *
+     * @return The const past-the-end iterator.
+     */
+    ConstIterator end() const
+    {
+        return iterator_at(nullptr);
+    }
+
+    /**
+     * @brief Same as begin() const, for a list that is not const.
+     *
+     * @return A const iterator to the first element.
+     */
+    ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    /**
+     * @brief Same as end() const, for a list that is not const.
+     *
+     * @return The const past-the-end iterator.
+     */
+    ConstIterator cend() const
+    {
+        return end();
+    }
+
+    /**
+     * @brief Returns an iterator to the last element that walks towards the
+     * head.
+     *
+     * @return A reverse iterator to the last element.
+     */
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns the reverse iterator past the first element.
+     *
+     * @return The reverse past-the-end iterator.
+     */
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns a read-only iterator to the last element that walks
+     * towards the head.
+     *
+     * @return A const reverse iterator to the last element.
+     */
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief Returns the read-only reverse iterator past the first element.
+     *
+     * @return The const reverse past-the-end iterator.
+     */
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief Returns the list seen in the other direction, in O(1).
+     *
+     * Unlike reverse(), no link is rewritten: the view iterates from the tail
+     * through prev links, so flipping the direction to walk the list and
+     * flipping it back costs nothing. Use reverse() only when the order of
+     * the list itself has to change.
+     *
+     * @return A view from the tail to the head.
+     */
+    Reversed reversed()
+    {
+        return Reversed{this};
     }
 };
 
+/**
+ * @brief dlist keeping its first N nodes inside the list object.
+ *
+ * Creating and destroying lists of up to N elements never touches the heap;
+ * nodes beyond N are allocated with new. See inline_pool.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam N The number of inline nodes.
+ */
+template <typename T, size_t N = 8> using small_dlist = dlist<T, inline_pool<T, N>>;
+
 } // namespace cxc
 
 #include "dlist.cpp"
@@ -0,0 +1,188 @@
+#ifndef CXC_EPOCH_TPP
+#define CXC_EPOCH_TPP
+
+#include "epoch.h"
+
+namespace cxc
+{
+
+/**
+ * @brief Enters a read section, publishing the current global epoch if it is
+ * the outermost one.
+ *
+ * The fence orders the published epoch before every link the section reads,
+ * against the fence of advance().
+ */
+inline void epoch_record::enter()
+{
+    if (depth++ != 0)
+        return;
+
+    epoch.store(epoch_domain::instance().current(), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Leaves a read section, withdrawing the epoch with the outermost one.
+ */
+inline void epoch_record::exit()
+{
+    if (--depth == 0)
+        epoch.store(0, std::memory_order_release);
+}
+
+/**
+ * @brief Frees every record when the program exits.
+ */
+inline epoch_domain::~epoch_domain()
+{
+    epoch_record *record = records.load();
+
+    while (record != nullptr)
+    {
+        epoch_record *next = record->next;
+        delete record;
+        record = next;
+    }
+}
+
+/**
+ * @brief Returns the process-wide epoch domain.
+ *
+ * @return Reference to the domain.
+ */
+inline epoch_domain &epoch_domain::instance()
+{
+    static epoch_domain domain;
+    return domain;
+}
+
+/**
+ * @brief Takes over a released record, or adds a new one to the domain.
+ *
+ * @return The record now owned by the calling thread.
+ */
+inline epoch_record *epoch_domain::acquire()
+{
+    for (epoch_record *record = records.load(); record != nullptr; record = record->next)
+    {
+        bool expected = false;
+
+        if (!record->active.load(std::memory_order_relaxed) && record->active.compare_exchange_strong(expected, true))
+            return record;
+    }
+
+    epoch_record *record = new epoch_record;
+    record->active.store(true, std::memory_order_relaxed);
+    record->next = records.load();
+
+    while (!records.compare_exchange_weak(record->next, record))
+    {
+    }
+
+    return record;
+}
+
+/**
+ * @brief Gives a record back to the domain when its thread exits.
+ *
+ * @param record The record to release.
+ */
+inline void epoch_domain::release(epoch_record *record)
+{
+    record->depth = 0;
+    record->epoch.store(0, std::memory_order_relaxed);
+    record->active.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the global epoch, the tag of a node unlinked now.
+ *
+ * @return The current epoch.
+ */
+inline uint64_t epoch_domain::current()
+{
+    return global.load(std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Starts a new epoch and returns the oldest one a reader may still be
+ * in.
+ *
+ * Nodes tagged with an epoch smaller than the returned one are unreachable
+ * by every reader: readers that entered before they were unlinked published
+ * an epoch at most equal to their tag.
+ *
+ * @return The smallest epoch published by a reader, or the new global epoch
+ * if no thread is reading.
+ */
+inline uint64_t epoch_domain::advance()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t oldest = global.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (epoch_record *record = records.load(std::memory_order_acquire); record != nullptr; record = record->next)
+    {
+        uint64_t epoch = record->epoch.load(std::memory_order_relaxed);
+
+        if (epoch != 0 && epoch < oldest)
+            oldest = epoch;
+    }
+
+    return oldest;
+}
+
+/**
+ * @brief Returns the epoch record of the calling thread, acquiring it on
+ * first use and releasing it when the thread exits.
+ *
+ * @return Reference to the thread's record.
+ */
+inline epoch_record &this_thread_epoch()
+{
+    struct owner
+    {
+        epoch_record *record = epoch_domain::instance().acquire();
+
+        ~owner()
+        {
+            epoch_domain::instance().release(record);
+        }
+    };
+
+    thread_local owner current;
+    return *current.record;
+}
+
+/**
+ * @brief Enters a read section on the calling thread.
+ */
+inline epoch_guard::epoch_guard() : record(&this_thread_epoch())
+{
+    record->enter();
+}
+
+/**
+ * @brief Extends the read section of another guard of the same thread.
+ *
+ * @param other The guard to copy.
+ */
+inline epoch_guard::epoch_guard(const epoch_guard &other) : record(other.record)
+{
+    record->enter();
+}
+
+/**
+ * @brief Leaves the read section.
+ */
+inline epoch_guard::~epoch_guard()
+{
+    record->exit();
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef CXC_EPOCH_H
+#define CXC_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace cxc
+{
+
+/**
+ * @brief Per-thread record of an epoch domain.
+ *
+ * While a thread is inside a read section, its record holds the global epoch
+ * read on entry; a node unlinked before that epoch began cannot be reached by
+ * the thread, and may be freed. Sections nest, only the outermost one
+ * publishes an epoch.
+ */
+struct epoch_record
+{
+    // 0 outside a read section
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<bool> active{false};
+    epoch_record *next = nullptr;
+    // nesting of read sections, only touched by the owning thread
+    size_t depth = 0;
+
+    void enter();
+
+    void exit();
+};
+
+/**
+ * @brief Process-wide epoch counter and list of epoch records.
+ *
+ * A writer tags each node it unlinks with current(), and frees it once
+ * advance() returns a larger epoch. Records are never freed while the
+ * program runs, a record released by an exiting thread is reused by the next
+ * thread asking for one.
+ */
+struct epoch_domain
+{
+  private:
+    std::atomic<epoch_record *> records{nullptr};
+    std::atomic<uint64_t> global{1};
+
+  public:
+    epoch_domain() = default;
+    epoch_domain(const epoch_domain &) = delete;
+    epoch_domain &operator=(const epoch_domain &) = delete;
+    ~epoch_domain();
+
+    static epoch_domain &instance();
+
+    epoch_record *acquire();
+
+    void release(epoch_record *record);
+
+    uint64_t current();
+
+    uint64_t advance();
+};
+
+epoch_record &this_thread_epoch();
+
+/**
+ * @brief Keeps the calling thread in a read section of the process-wide
+ * epoch domain for its lifetime.
+ *
+ * Copies extend the section, a guard must stay on the thread that made it.
+ */
+struct epoch_guard
+{
+  private:
+    epoch_record *record;
+
+  public:
+    epoch_guard();
+    epoch_guard(const epoch_guard &other);
+    epoch_guard &operator=(const epoch_guard &) = delete;
+    ~epoch_guard();
+};
+
+} // namespace cxc
+
+#include "epoch.cpp"
+
+#endif
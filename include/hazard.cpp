@@ -0,0 +1,193 @@
+#ifndef CXC_HAZARD_TPP
+#define CXC_HAZARD_TPP
+
+#include "hazard.h"
+
+#include <algorithm>
+
+namespace cxc
+{
+
+/**
+ * @brief Publishes a pointer the thread is about to dereference.
+ *
+ * The caller must check afterwards that the pointer is still reachable from
+ * the shared structure before using it.
+ *
+ * @param slot The slot to publish the pointer in.
+ * @param ptr The pointer to protect.
+ */
+inline void hazard_record::protect(size_t slot, void *ptr)
+{
+    hazards[slot].store(ptr, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Withdraws every pointer published by the thread.
+ */
+inline void hazard_record::clear()
+{
+    for (std::atomic<void *> &hazard : hazards)
+        hazard.store(nullptr, std::memory_order_release);
+}
+
+/**
+ * @brief Hands over a node unlinked from a shared structure, to be freed once
+ * no thread protects it anymore.
+ *
+ * @param ptr The node to free.
+ * @param deleter The function freeing the node.
+ */
+inline void hazard_record::retire(void *ptr, void (*deleter)(void *))
+{
+    retired.push_back(retired_ptr{ptr, deleter});
+
+    if (retired.size() >= hazard_domain::instance().threshold())
+        scan();
+}
+
+/**
+ * @brief Frees every retired node that no thread protects.
+ */
+inline void hazard_record::scan()
+{
+    std::vector<void *> protected_ptrs;
+    hazard_domain::instance().collect(protected_ptrs);
+
+    std::sort(protected_ptrs.begin(), protected_ptrs.end());
+
+    auto keep = std::partition(retired.begin(), retired.end(), [&protected_ptrs](const retired_ptr &node) {
+        return std::binary_search(protected_ptrs.begin(), protected_ptrs.end(), node.ptr);
+    });
+
+    for (auto it = keep; it != retired.end(); ++it)
+        it->deleter(it->ptr);
+
+    retired.erase(keep, retired.end());
+}
+
+/**
+ * @brief Frees every record and every node still retired when the program
+ * exits.
+ */
+inline hazard_domain::~hazard_domain()
+{
+    hazard_record *record = records.load();
+
+    while (record != nullptr)
+    {
+        hazard_record *next = record->next;
+
+        for (hazard_record::retired_ptr &node : record->retired)
+            node.deleter(node.ptr);
+
+        delete record;
+        record = next;
+    }
+}
+
+/**
+ * @brief Returns the process-wide hazard pointer domain.
+ *
+ * @return Reference to the domain.
+ */
+inline hazard_domain &hazard_domain::instance()
+{
+    static hazard_domain domain;
+    return domain;
+}
+
+/**
+ * @brief Takes over a released record, or adds a new one to the domain.
+ *
+ * @return The record now owned by the calling thread.
+ */
+inline hazard_record *hazard_domain::acquire()
+{
+    for (hazard_record *record = records.load(); record != nullptr; record = record->next)
+    {
+        bool expected = false;
+
+        if (!record->active.load(std::memory_order_relaxed) && record->active.compare_exchange_strong(expected, true))
+            return record;
+    }
+
+    hazard_record *record = new hazard_record;
+    record->active.store(true, std::memory_order_relaxed);
+    record->next = records.load();
+
+    while (!records.compare_exchange_weak(record->next, record))
+    {
+    }
+
+    record_count.fetch_add(1);
+    return record;
+}
+
+/**
+ * @brief Gives a record back to the domain when its thread exits.
+ *
+ * @param record The record to release.
+ */
+inline void hazard_domain::release(hazard_record *record)
+{
+    record->clear();
+    record->active.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief Number of retired nodes a record accumulates before scanning, twice
+ * the number of hazard slots so that a scan frees at least half of them.
+ *
+ * @return The scan threshold.
+ */
+inline size_t hazard_domain::threshold()
+{
+    return 2 * hazard_record::slots * record_count.load(std::memory_order_relaxed) + 64;
+}
+
+/**
+ * @brief Collects every pointer currently published in the domain.
+ *
+ * @param hazards Receives the published pointers.
+ */
+inline void hazard_domain::collect(std::vector<void *> &hazards)
+{
+    for (hazard_record *record = records.load(); record != nullptr; record = record->next)
+    {
+        for (std::atomic<void *> &hazard : record->hazards)
+        {
+            void *ptr = hazard.load(std::memory_order_seq_cst);
+
+            if (ptr != nullptr)
+                hazards.push_back(ptr);
+        }
+    }
+}
+
+/**
+ * @brief Returns the hazard record of the calling thread, acquiring it on
+ * first use and releasing it when the thread exits.
+ *
+ * @return Reference to the thread's record.
+ */
+inline hazard_record &this_thread_hazards()
+{
+    struct owner
+    {
+        hazard_record *record = hazard_domain::instance().acquire();
+
+        ~owner()
+        {
+            record->scan();
+            hazard_domain::instance().release(record);
+        }
+    };
+
+    thread_local owner current;
+    return *current.record;
+}
+
+} // namespace cxc
+
+#endif
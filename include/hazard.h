@@ -0,0 +1,78 @@
+#ifndef CXC_HAZARD_H
+#define CXC_HAZARD_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Per-thread record of a hazard pointer domain.
+ *
+ * A thread publishes in its slots the nodes it is about to dereference; a
+ * retired node is only freed once no slot of any record points to it.
+ * Retired nodes wait in the record of the thread that retired them, and stay
+ * there when the thread exits until another thread takes over the record.
+ */
+struct hazard_record
+{
+    static constexpr size_t slots = 2;
+
+    struct retired_ptr
+    {
+        void *ptr;
+        void (*deleter)(void *);
+    };
+
+    std::atomic<void *> hazards[slots]{};
+    std::atomic<bool> active{false};
+    hazard_record *next = nullptr;
+    std::vector<retired_ptr> retired{};
+
+    void protect(size_t slot, void *ptr);
+
+    void clear();
+
+    void retire(void *ptr, void (*deleter)(void *));
+
+    void scan();
+};
+
+/**
+ * @brief Process-wide list of hazard records.
+ *
+ * Records are never freed while the program runs, a record released by an
+ * exiting thread is reused by the next thread asking for one.
+ */
+struct hazard_domain
+{
+  private:
+    std::atomic<hazard_record *> records{nullptr};
+    std::atomic<size_t> record_count{0};
+
+  public:
+    hazard_domain() = default;
+    hazard_domain(const hazard_domain &) = delete;
+    hazard_domain &operator=(const hazard_domain &) = delete;
+    ~hazard_domain();
+
+    static hazard_domain &instance();
+
+    hazard_record *acquire();
+
+    void release(hazard_record *record);
+
+    size_t threshold();
+
+    void collect(std::vector<void *> &hazards);
+};
+
+hazard_record &this_thread_hazards();
+
+} // namespace cxc
+
+#include "hazard.cpp"
+
+#endif
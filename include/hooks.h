@@ -0,0 +1,91 @@
+#ifndef CXC_HOOKS_H
+#define CXC_HOOKS_H
+
+#include "events.h"
+
+#include <cstddef>
+
+namespace cxc
+{
+
+enum class Events
+{
+    INCREASE_COUNT,
+    DECREASE_COUNT,
+    EMPTY_COUNT
+};
+
+/**
+ * @brief Default mutation hooks of dlist.
+ *
+ * The list calls its hooks on every insertion and removal. These ones only
+ * keep the element count, inline, without any lookup or type-erased call.
+ *
+ * dlist derives from its hooks, so their public members are part of the
+ * list's interface: the callbacks are protected, for dlist only.
+ */
+struct size_hooks
+{
+  protected:
+    void bind(size_t &)
+    {
+    }
+
+    void on_increase(size_t &size, size_t count = 1)
+    {
+        size += count;
+    }
+
+    void on_decrease(size_t &size, size_t count = 1)
+    {
+        size -= count;
+    }
+
+    void on_empty(size_t &size)
+    {
+        size = 0;
+    }
+};
+
+/**
+ * @brief Mutation hooks that dispatch through an EventListener.
+ *
+ * Every mutation triggers the matching Events value on the public _events
+ * member, whose default handlers keep the element count. Handlers can be
+ * replaced to observe the list, at the price of a map lookup and a
+ * std::function call per insertion and removal. Bulk operations trigger one
+ * event per element.
+ */
+struct event_hooks
+{
+    cxc::EventListener<Events> _events{};
+
+  protected:
+    void bind(size_t &size)
+    {
+        _events.add(Events::EMPTY_COUNT, [&size]() { size = 0; });
+        _events.add(Events::INCREASE_COUNT, [&size]() { size++; });
+        _events.add(Events::DECREASE_COUNT, [&size]() { size--; });
+    }
+
+    void on_increase(size_t &, size_t count = 1)
+    {
+        for (size_t i = 0; i < count; i++)
+            _events.trigger(Events::INCREASE_COUNT);
+    }
+
+    void on_decrease(size_t &, size_t count = 1)
+    {
+        for (size_t i = 0; i < count; i++)
+            _events.trigger(Events::DECREASE_COUNT);
+    }
+
+    void on_empty(size_t &)
+    {
+        _events.trigger(Events::EMPTY_COUNT);
+    }
+};
+
+} // namespace cxc
+
+#endif
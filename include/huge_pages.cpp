@@ -0,0 +1,151 @@
+#ifndef CXC_HUGE_PAGES_TPP
+#define CXC_HUGE_PAGES_TPP
+
+#include "huge_pages.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define CXC_HUGE_PAGES_MMAP
+#endif
+
+namespace cxc
+{
+
+/**
+ * @brief Maps a slab aligned on the huge page size and asks the kernel to
+ * back it with huge pages, or takes it from operator new if it is smaller
+ * than a huge page.
+ *
+ * @param bytes The size of the slab, rounded up to a multiple of the huge
+ * page size if it is mapped.
+ * @param alignment The alignment of the slab, at most the huge page size.
+ * @return Pointer to the slab.
+ * @throws std::bad_alloc if the mapping fails.
+ */
+inline void *huge_page_slabs::allocate(size_t &bytes, size_t alignment)
+{
+#if defined(CXC_HUGE_PAGES_MMAP)
+    if (bytes < huge_page_size)
+        return heap_slabs::allocate(bytes, alignment);
+
+    bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+
+    // over-reserve by one huge page and trim both ends to get the alignment
+    size_t reserved = bytes + huge_page_size;
+    void *memory = ::mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (memory == MAP_FAILED)
+        throw std::bad_alloc();
+
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+    std::uintptr_t start = (address + huge_page_size - 1) & ~std::uintptr_t(huge_page_size - 1);
+    size_t head = start - address;
+
+    if (head != 0)
+        ::munmap(memory, head);
+
+    if (reserved - head - bytes != 0)
+        ::munmap(reinterpret_cast<void *>(start + bytes), reserved - head - bytes);
+
+#if defined(MADV_HUGEPAGE)
+    // a refusal leaves the slab on regular pages
+    ::madvise(reinterpret_cast<void *>(start), bytes, MADV_HUGEPAGE);
+#endif
+
+    return reinterpret_cast<void *>(start);
+#else
+    return heap_slabs::allocate(bytes, alignment);
+#endif
+}
+
+/**
+ * @brief Unmaps a slab mapped by allocate(), or frees it if it came from
+ * operator new.
+ *
+ * @param memory The slab.
+ * @param bytes The size allocate() rounded it up to.
+ * @param alignment The alignment it was allocated with.
+ */
+inline void huge_page_slabs::deallocate(void *memory, size_t bytes, size_t alignment)
+{
+#if defined(CXC_HUGE_PAGES_MMAP)
+    if (bytes < huge_page_size)
+        heap_slabs::deallocate(memory, bytes, alignment);
+    else
+        ::munmap(memory, bytes);
+#else
+    heap_slabs::deallocate(memory, bytes, alignment);
+#endif
+}
+
+/**
+ * @brief Returns how many bytes of the given slabs the kernel backs with huge
+ * pages.
+ *
+ * /proc/self/smaps is read once and gives the huge page bytes of each
+ * mapping, which are matched against every mapped slab; adjacent slabs may be
+ * merged into one mapping, whose huge pages are then shared among them in
+ * proportion to their size. Slabs smaller than a huge page came from operator
+ * new and are skipped.
+ *
+ * @param slabs The address and size of each slab.
+ * @return The estimated bytes on huge pages, 0 if smaps cannot be read.
+ */
+inline size_t huge_page_slabs::huge_page_bytes(const std::vector<std::pair<const void *, size_t>> &slabs)
+{
+    std::ifstream smaps("/proc/self/smaps");
+
+    if (!smaps)
+        return 0;
+
+    std::uintptr_t start = 0;
+    std::uintptr_t end = 0;
+    double total = 0;
+    std::string line;
+
+    while (std::getline(smaps, line))
+    {
+        // mapping headers start with "start-end", field lines with a name
+        char *dash = nullptr;
+        std::uintptr_t value = std::strtoull(line.c_str(), &dash, 16);
+
+        if (dash != nullptr && *dash == '-')
+        {
+            start = value;
+            end = std::strtoull(dash + 1, nullptr, 16);
+            continue;
+        }
+
+        if (line.compare(0, 14, "AnonHugePages:") != 0)
+            continue;
+
+        double huge = static_cast<double>(std::strtoull(line.c_str() + 14, nullptr, 10)) * 1024;
+
+        if (huge == 0)
+            continue;
+
+        for (const auto &slab : slabs)
+        {
+            std::uintptr_t first = reinterpret_cast<std::uintptr_t>(slab.first);
+            std::uintptr_t last = first + slab.second;
+
+            if (slab.second < huge_page_size || end <= first || start >= last)
+                continue;
+
+            std::uintptr_t overlap = (end < last ? end : last) - (start > first ? start : first);
+            total += huge * static_cast<double>(overlap) / static_cast<double>(end - start);
+        }
+    }
+
+    return static_cast<size_t>(total);
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef CXC_HUGE_PAGES_H
+#define CXC_HUGE_PAGES_H
+
+#include "pool.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Slab source of node_pool mapping slabs on transparent huge pages.
+ *
+ * Slabs grow geometrically up to max_slab nodes. The first ones are smaller
+ * than a huge page and come from operator new like heap_slabs, so that a
+ * small list does not pin 2 MiB; from huge_page_size bytes on, slabs are
+ * anonymous mappings aligned on and rounded up to the huge page size and
+ * advised with MADV_HUGEPAGE, so a very large list is covered by few TLB
+ * entries. Where the kernel has no transparent huge pages, or refuses them,
+ * the mappings use regular pages; on systems without mmap, every slab comes
+ * from operator new.
+ *
+ * huge_page_bytes() reads /proc/self/smaps once on Linux and returns 0
+ * elsewhere; only mapped slabs are counted.
+ */
+struct huge_page_slabs
+{
+    static constexpr size_t huge_page_size = size_t(2) << 20;
+
+    static constexpr size_t min_slab = 64;
+    static constexpr size_t max_slab = size_t(1) << 22;
+
+    static void *allocate(size_t &bytes, size_t alignment);
+
+    static void deallocate(void *memory, size_t bytes, size_t alignment);
+
+    static size_t huge_page_bytes(const std::vector<std::pair<const void *, size_t>> &slabs);
+};
+
+/**
+ * @brief node_pool whose slabs are placed on transparent huge pages.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ */
+template <typename T> using huge_page_pool = node_pool<T, huge_page_slabs>;
+
+} // namespace cxc
+
+#include "huge_pages.cpp"
+
+#endif
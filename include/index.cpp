@@ -0,0 +1,499 @@
+#ifndef CXC_INDEX_TPP
+#define CXC_INDEX_TPP
+
+#include "index.h"
+
+#include <new>
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Finds the node at a position by walking from the closer end of the
+ * list.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param head The first node of the list.
+ * @param tail The last node of the list.
+ * @param size The number of nodes in the list.
+ * @param position The position of the node, smaller than size.
+ * @return Pointer to the node at the position.
+ */
+template <typename T>
+Node<T> *linear_index<T>::find(Node<T> *head, Node<T> *tail, size_t size, size_t position)
+{
+    if (position < size / 2)
+    {
+        CXC_DLIST_STAT(traversed += position;)
+
+        Node<T> *node = head;
+
+        for (size_t i = 0; i < position; i++)
+            node = node->next;
+
+        return node;
+    }
+
+    CXC_DLIST_STAT(traversed += size - 1 - position;)
+
+    Node<T> *node = tail;
+
+    for (size_t i = size - 1; i > position; i--)
+        node = node->prev;
+
+    return node;
+}
+
+/**
+ * @brief Takes over the towers of another index, which is left empty and
+ * invalid.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param other The index of the list whose nodes this list takes over.
+ */
+template <typename T> skip_index<T>::skip_index(skip_index &&other) noexcept
+{
+    *this = std::move(other);
+}
+
+/**
+ * @brief Frees the towers of this index and takes over those of another
+ * index, which is left empty and invalid.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param other The index of the list whose nodes this list takes over.
+ * @return Reference to this index.
+ */
+template <typename T> skip_index<T> &skip_index<T>::operator=(skip_index &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    release();
+
+    for (size_t l = 0; l < max_level; l++)
+    {
+        header[l] = other.header[l];
+        other.header[l] = Link{};
+    }
+
+    towers = std::move(other.towers);
+    other.towers.clear();
+    levels = std::exchange(other.levels, 0);
+    valid = std::exchange(other.valid, false);
+    seed = other.seed;
+
+    return *this;
+}
+
+/**
+ * @brief Frees every express tower.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> skip_index<T>::~skip_index()
+{
+    release();
+}
+
+/**
+ * @brief Draws the number of express levels of a new node, each level being
+ * reached with probability 1/4.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @return The height of the tower, 0 when the node gets none.
+ */
+template <typename T> size_t skip_index<T>::random_height()
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    uint64_t bits = seed;
+    size_t height = 0;
+
+    while (height < max_level && (bits & 3) == 0)
+    {
+        height++;
+        bits >>= 2;
+    }
+
+    return height;
+}
+
+/**
+ * @brief Allocates the express tower of a node.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param node The node the tower stands on.
+ * @param height The number of express levels of the tower.
+ * @return Pointer to the new tower, its links are left uninitialized.
+ */
+template <typename T> typename skip_index<T>::Tower *skip_index<T>::create_tower(Node<T> *node, size_t height)
+{
+    void *memory = ::operator new(sizeof(Tower) + height * sizeof(Link));
+    return new (memory) Tower{node, height};
+}
+
+/**
+ * @brief Frees every tower and empties the header.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> void skip_index<T>::release()
+{
+    Tower *tower = header[0].next;
+
+    while (tower != nullptr)
+    {
+        Tower *next = tower->links()[0].next;
+        ::operator delete(tower);
+        tower = next;
+    }
+
+    for (size_t l = 0; l < max_level; l++)
+        header[l] = Link{};
+
+    towers.clear();
+    levels = 0;
+}
+
+/**
+ * @brief Rebuilds every tower in a single pass over the list.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param head The first node of the list.
+ */
+template <typename T> void skip_index<T>::rebuild(Node<T> *head)
+{
+    release();
+
+    Link *last[max_level];
+    Tower *last_tower[max_level];
+    size_t last_rank[max_level];
+
+    for (size_t l = 0; l < max_level; l++)
+    {
+        last[l] = header;
+        last_tower[l] = nullptr;
+        last_rank[l] = 0;
+    }
+
+    size_t rank = 0;
+
+    for (Node<T> *node = head; node != nullptr; node = node->next)
+    {
+        rank++;
+
+        size_t height = random_height();
+
+        if (height == 0)
+            continue;
+
+        Tower *tower = create_tower(node, height);
+        towers.emplace(node, tower);
+
+        for (size_t l = 0; l < height; l++)
+        {
+            last[l][l].next = tower;
+            last[l][l].width = rank - last_rank[l];
+            tower->links()[l].prev = last_tower[l];
+            last[l] = tower->links();
+            last_tower[l] = tower;
+            last_rank[l] = rank;
+        }
+
+        if (height > levels)
+            levels = height;
+    }
+
+    // the last tower of every level links to the past-the-end rank
+    for (size_t l = 0; l < max_level; l++)
+    {
+        last[l][l].next = nullptr;
+        last[l][l].width = rank + 1 - last_rank[l];
+    }
+
+    valid = true;
+}
+
+/**
+ * @brief Returns the tower owning a links array.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param links The links of a tower, or the header.
+ * @return The tower, nullptr for the header.
+ */
+template <typename T> typename skip_index<T>::Tower *skip_index<T>::owner(Link *links)
+{
+    return links == header ? nullptr : reinterpret_cast<Tower *>(links) - 1;
+}
+
+/**
+ * @brief Collects, on every level, the last tower ranked before a rank.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param rank The rank (position + 1) to search for.
+ * @param update Receives the links array of the predecessor on each level.
+ * @param ranks Receives the rank of the predecessor on each level.
+ */
+template <typename T> void skip_index<T>::predecessors(size_t rank, Link **update, size_t *ranks)
+{
+    Link *links = header;
+    size_t current = 0;
+
+    for (size_t l = max_level; l-- > 0;)
+    {
+        if (l < levels)
+        {
+            while (links[l].next != nullptr && current + links[l].width < rank)
+            {
+                current += links[l].width;
+                links = links[l].next->links();
+            }
+        }
+
+        update[l] = links;
+        ranks[l] = current;
+    }
+}
+
+/**
+ * @brief Computes the rank of a linked node.
+ *
+ * Walks back along the list to the closest node with a tower, then climbs
+ * back to the header through the top level of every tower met, adding up
+ * the widths of the links followed.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param node The node, linked into the list.
+ * @return The rank (position + 1) of the node.
+ */
+template <typename T> size_t skip_index<T>::rank_of(Node<T> *node)
+{
+    size_t rank = 1;
+    Tower *tower = nullptr;
+
+    for (Node<T> *prev = node->prev; prev != nullptr; prev = prev->prev)
+    {
+        auto found = towers.find(prev);
+
+        if (found != towers.end())
+        {
+            tower = found->second;
+            break;
+        }
+
+        rank++;
+    }
+
+    while (tower != nullptr)
+    {
+        size_t l = tower->height - 1;
+        Tower *prev = tower->links()[l].prev;
+
+        rank += (prev != nullptr ? prev->links() : header)[l].width;
+        tower = prev;
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Finds the node at a position through the express towers.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param head The first node of the list.
+ * @param tail The last node of the list.
+ * @param size The number of nodes in the list.
+ * @param position The position of the node, smaller than size.
+ * @return Pointer to the node at the position.
+ */
+template <typename T> Node<T> *skip_index<T>::find(Node<T> *head, Node<T> *tail, size_t size, size_t position)
+{
+    if (!valid)
+        rebuild(head);
+
+    size_t target = position + 1;
+    size_t rank = 0;
+    Link *links = header;
+    Node<T> *node = nullptr;
+
+    for (size_t l = levels; l-- > 0;)
+    {
+        while (links[l].next != nullptr && rank + links[l].width <= target)
+        {
+            CXC_DLIST_STAT(traversed++;)
+
+            rank += links[l].width;
+            node = links[l].next->node;
+            links = links[l].next->links();
+        }
+    }
+
+    if (size - position < target - rank)
+    {
+        CXC_DLIST_STAT(traversed += size - 1 - position;)
+
+        node = tail;
+
+        for (size_t i = size - 1; i > position; i--)
+            node = node->prev;
+
+        return node;
+    }
+
+    if (node == nullptr)
+    {
+        node = head;
+        rank = 1;
+    }
+
+    CXC_DLIST_STAT(traversed += target - rank;)
+
+    for (; rank < target; rank++)
+        node = node->next;
+
+    return node;
+}
+
+/**
+ * @brief Records a node linked at a position, giving it a tower at random.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param position The position of the new node.
+ * @param node The new node, already linked into the list.
+ */
+template <typename T> void skip_index<T>::inserted(size_t position, Node<T> *node)
+{
+    if (!valid)
+        return;
+
+    size_t rank = position + 1;
+    Link *update[max_level];
+    size_t ranks[max_level];
+
+    predecessors(rank, update, ranks);
+
+    size_t height = random_height();
+    Tower *tower = height > 0 ? create_tower(node, height) : nullptr;
+
+    if (tower != nullptr)
+        towers.emplace(node, tower);
+
+    for (size_t l = 0; l < max_level; l++)
+    {
+        Link &prev = update[l][l];
+
+        if (l < height)
+        {
+            tower->links()[l] = Link{prev.next, owner(update[l]), ranks[l] + prev.width + 1 - rank};
+
+            if (prev.next != nullptr)
+                prev.next->links()[l].prev = tower;
+
+            prev.next = tower;
+            prev.width = rank - ranks[l];
+        }
+        else
+        {
+            prev.width++;
+        }
+    }
+
+    if (height > levels)
+        levels = height;
+}
+
+/**
+ * @brief Forgets a node about to be removed from a position.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param position The position of the node.
+ * @param node The node, still linked into the list.
+ */
+template <typename T> void skip_index<T>::erased(size_t position, Node<T> *node)
+{
+    if (!valid)
+        return;
+
+    size_t rank = position + 1;
+    Link *update[max_level];
+    size_t ranks[max_level];
+
+    predecessors(rank, update, ranks);
+
+    Tower *tower = nullptr;
+
+    for (size_t l = 0; l < max_level; l++)
+    {
+        Link &prev = update[l][l];
+
+        if (prev.next != nullptr && prev.next->node == node)
+        {
+            tower = prev.next;
+
+            Link &gone = tower->links()[l];
+            prev.width += gone.width - 1;
+            prev.next = gone.next;
+
+            if (gone.next != nullptr)
+                gone.next->links()[l].prev = gone.prev;
+        }
+        else
+        {
+            prev.width--;
+        }
+    }
+
+    if (tower != nullptr)
+    {
+        towers.erase(node);
+        ::operator delete(tower);
+    }
+}
+
+/**
+ * @brief Records a node linked next to other nodes, without knowing its
+ * position.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param node The new node, already linked into the list.
+ */
+template <typename T> void skip_index<T>::inserted(Node<T> *node)
+{
+    if (valid)
+        inserted(rank_of(node) - 1, node);
+}
+
+/**
+ * @brief Forgets a node about to be removed, without knowing its position.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param node The node, still linked into the list.
+ */
+template <typename T> void skip_index<T>::erased(Node<T> *node)
+{
+    if (valid)
+        erased(rank_of(node) - 1, node);
+}
+
+/**
+ * @brief Drops the towers, the next lookup rebuilds them.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> void skip_index<T>::invalidate()
+{
+    // nothing to free until the next rebuild, erasing in a loop stays O(1)
+    if (!valid)
+        return;
+
+    release();
+    valid = false;
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef CXC_INDEX_H
+#define CXC_INDEX_H
+
+#include "node.h"
+#include "stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace cxc
+{
+
+/**
+ * @brief Default positional index of dlist.
+ *
+ * Keeps no state and finds a position by walking from whichever end of the
+ * list is closer, so positional operations cost at most n / 2 steps.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> struct linear_index
+{
+    // nodes walked by find, with CXC_DLIST_STATS
+    CXC_DLIST_STAT(size_t traversed = 0;)
+
+    Node<T> *find(Node<T> *head, Node<T> *tail, size_t size, size_t position);
+
+    void inserted(size_t, Node<T> *)
+    {
+    }
+
+    void erased(size_t, Node<T> *)
+    {
+    }
+
+    void inserted(Node<T> *)
+    {
+    }
+
+    void erased(Node<T> *)
+    {
+    }
+
+    void invalidate()
+    {
+    }
+};
+
+/**
+ * @brief Order-statistic positional index of dlist.
+ *
+ * An indexable skip list is layered over the nodes of the list: about one node
+ * in four gets an express tower whose links record how many nodes they jump
+ * over, so get_node, change, insert_at and remove_at find their position in
+ * O(log n) expected steps. The list itself is the bottom level.
+ *
+ * Insertions and removals at a position keep the index up to date in
+ * O(log n). So do insertions and removals at an iterator: towers link back
+ * to their predecessor on every level and are found from their node through
+ * a hash map, so the rank of a node is recovered in O(log n) expected steps.
+ * Operations that relink many nodes at once (sort, splice between lists,
+ * relayout, reverse, clear) invalidate it, and it is rebuilt in one O(n)
+ * pass by the next positional lookup.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> struct skip_index
+{
+    static constexpr size_t max_level = 32;
+
+  private:
+    struct Tower;
+
+    struct Link
+    {
+        Tower *next;
+        // nullptr for the header
+        Tower *prev;
+        size_t width;
+    };
+
+    struct Tower
+    {
+        Node<T> *node;
+        size_t height;
+
+        Link *links()
+        {
+            return reinterpret_cast<Link *>(this + 1);
+        }
+    };
+
+    // links of the virtual tower standing before the first node, at rank 0
+    Link header[max_level]{};
+    std::unordered_map<const Node<T> *, Tower *> towers;
+    size_t levels = 0;
+    bool valid = false;
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+
+    size_t random_height();
+
+    Tower *create_tower(Node<T> *node, size_t height);
+
+    void release();
+
+    void rebuild(Node<T> *head);
+
+    Tower *owner(Link *links);
+
+    void predecessors(size_t rank, Link **update, size_t *ranks);
+
+    size_t rank_of(Node<T> *node);
+
+  public:
+    // links and nodes walked by find, with CXC_DLIST_STATS
+    CXC_DLIST_STAT(size_t traversed = 0;)
+
+    skip_index() = default;
+    skip_index(const skip_index &) = delete;
+    skip_index(skip_index &&other) noexcept;
+    skip_index &operator=(const skip_index &) = delete;
+    skip_index &operator=(skip_index &&other) noexcept;
+    ~skip_index();
+
+    Node<T> *find(Node<T> *head, Node<T> *tail, size_t size, size_t position);
+
+    void inserted(size_t position, Node<T> *node);
+
+    void erased(size_t position, Node<T> *node);
+
+    void inserted(Node<T> *node);
+
+    void erased(Node<T> *node);
+
+    void invalidate();
+};
+
+} // namespace cxc
+
+#include "index.cpp"
+
+#endif
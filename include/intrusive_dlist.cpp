@@ -0,0 +1,254 @@
+#ifndef CXC_INTRUSIVE_DLIST_TPP
+#define CXC_INTRUSIVE_DLIST_TPP
+
+#include "intrusive_dlist.h"
+
+#include <stdexcept>
+
+namespace cxc
+{
+
+/**
+ * @brief Constructor for an empty intrusive list, the sentinel points to
+ * itself.
+ *
+ * @tparam T The type of the linked objects.
+ */
+template <typename T, typename Hook> intrusive_dlist<T, Hook>::intrusive_dlist()
+{
+    root.prev = &root;
+    root.next = &root;
+}
+
+/**
+ * @brief Destructor, unlinks every remaining object without destroying it.
+ *
+ * @tparam T The type of the linked objects.
+ */
+template <typename T, typename Hook> intrusive_dlist<T, Hook>::~intrusive_dlist()
+{
+    clear();
+}
+
+/**
+ * @brief Links a hook before the given position of the ring.
+ *
+ * @param position The hook to link before, the sentinel for the tail.
+ * @param hook The unlinked hook.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::link_before(hook_type *position, hook_type *hook)
+{
+    if (hook->is_linked())
+        throw std::runtime_error("[Error] insert: object is already linked in a list.");
+
+    hook->prev = position->prev;
+    hook->next = position;
+    hook->owner = this;
+    position->prev->next = hook;
+    position->prev = hook;
+
+    m_size++;
+}
+
+/**
+ * @brief Unlinks a hook from the ring and marks it unlinked.
+ *
+ * @param hook The linked hook.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::unlink(hook_type *hook)
+{
+    hook->prev->next = hook->next;
+    hook->next->prev = hook->prev;
+    hook->prev = nullptr;
+    hook->next = nullptr;
+    hook->owner = nullptr;
+
+    m_size--;
+}
+
+/**
+ * @brief Links an object at the head of the list.
+ *
+ * @tparam T The type of the linked objects.
+ * @param object The object to link, not linked through this hook yet.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::insert_head(T &object)
+{
+    link_before(root.next, Hook::to_hook(&object));
+}
+
+/**
+ * @brief Links an object at the tail of the list.
+ *
+ * @tparam T The type of the linked objects.
+ * @param object The object to link, not linked through this hook yet.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::insert_tail(T &object)
+{
+    link_before(&root, Hook::to_hook(&object));
+}
+
+/**
+ * @brief Links an object at the tail of the list, like dlist::insert.
+ *
+ * @tparam T The type of the linked objects.
+ * @param object The object to link, not linked through this hook yet.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::insert(T &object)
+{
+    insert_tail(object);
+}
+
+/**
+ * @brief Links an object before the given position.
+ *
+ * @tparam T The type of the linked objects.
+ * @param position The iterator to link before, end() for the tail.
+ * @param object The object to link, not linked through this hook yet.
+ * @return An iterator to the linked object.
+ */
+template <typename T, typename Hook>
+typename intrusive_dlist<T, Hook>::Iterator intrusive_dlist<T, Hook>::insert_before(Iterator position, T &object)
+{
+    hook_type *hook = Hook::to_hook(&object);
+    link_before(position.current, hook);
+
+    return Iterator(hook);
+}
+
+/**
+ * @brief Unlinks every object, leaving the objects themselves untouched.
+ *
+ * @tparam T The type of the linked objects.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::clear()
+{
+    hook_type *hook = root.next;
+
+    while (hook != &root)
+    {
+        hook_type *next = hook->next;
+        hook->prev = nullptr;
+        hook->next = nullptr;
+        hook->owner = nullptr;
+        hook = next;
+    }
+
+    root.prev = &root;
+    root.next = &root;
+    m_size = 0;
+}
+
+/**
+ * @brief Unlinks the object at the head of the list, if any.
+ *
+ * @tparam T The type of the linked objects.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::remove_head()
+{
+    if (is_empty())
+        return;
+
+    unlink(root.next);
+}
+
+/**
+ * @brief Unlinks the object at the tail of the list, if any.
+ *
+ * @tparam T The type of the linked objects.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::remove_tail()
+{
+    if (is_empty())
+        return;
+
+    unlink(root.prev);
+}
+
+/**
+ * @brief Unlinks an object of the list in O(1).
+ *
+ * @tparam T The type of the linked objects.
+ * @param object The object to unlink.
+ * @throws std::runtime_error if the object is not linked in this list.
+ */
+template <typename T, typename Hook> void intrusive_dlist<T, Hook>::remove(T &object)
+{
+    hook_type *hook = Hook::to_hook(&object);
+
+    if (hook->owner != this)
+        throw std::runtime_error("[Error] remove: object is not linked in this list.");
+
+    unlink(hook);
+}
+
+/**
+ * @brief Checks if the list is empty.
+ *
+ * @tparam T The type of the linked objects.
+ * @return true if the list is empty, false otherwise.
+ */
+template <typename T, typename Hook> bool intrusive_dlist<T, Hook>::is_empty()
+{
+    return root.next == &root;
+}
+
+/**
+ * @brief Returns the object at the head of the list.
+ *
+ * If the list is empty, a std::runtime_error is thrown.
+ *
+ * @tparam T The type of the linked objects.
+ * @return A reference to the head object.
+ */
+template <typename T, typename Hook> T &intrusive_dlist<T, Hook>::get_head()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access head data.");
+
+    return *Hook::to_object(root.next);
+}
+
+/**
+ * @brief Returns the object at the tail of the list.
+ *
+ * If the list is empty, a std::runtime_error is thrown.
+ *
+ * @tparam T The type of the linked objects.
+ * @return A reference to the tail object.
+ */
+template <typename T, typename Hook> T &intrusive_dlist<T, Hook>::get_tail()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access tail data.");
+
+    return *Hook::to_object(root.prev);
+}
+
+/**
+ * @brief Returns the number of linked objects.
+ *
+ * @tparam T The type of the linked objects.
+ * @return A const reference to the size of the list.
+ */
+template <typename T, typename Hook> const size_t &intrusive_dlist<T, Hook>::size()
+{
+    return m_size;
+}
+
+/**
+ * @brief Returns an iterator to an object linked in the list, in O(1).
+ *
+ * @tparam T The type of the linked objects.
+ * @param object The linked object.
+ * @return An iterator pointing to the object.
+ */
+template <typename T, typename Hook>
+typename intrusive_dlist<T, Hook>::Iterator intrusive_dlist<T, Hook>::iterator_to(T &object)
+{
+    return Iterator(Hook::to_hook(&object));
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef CXC_INTRUSIVE_DLIST_H
+#define CXC_INTRUSIVE_DLIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace cxc
+{
+
+/**
+ * @brief Links embedded in an object so that an intrusive_dlist can hold it.
+ *
+ * An object linked in several lists at once needs one hook per list, either
+ * as base classes (distinguished by the Tag parameter) or as members. A hook
+ * is not copied with its object: a copy starts unlinked. The hook records the
+ * list it is linked in, so that a list refuses to remove another list's
+ * object.
+ *
+ * @tparam Tag Distinguishes several hook bases of the same class.
+ */
+template <typename Tag = void> struct dlist_hook
+{
+    dlist_hook *prev = nullptr;
+    dlist_hook *next = nullptr;
+    // the list the hook is linked in
+    const void *owner = nullptr;
+
+    dlist_hook() = default;
+
+    dlist_hook(const dlist_hook &)
+    {
+    }
+
+    dlist_hook &operator=(const dlist_hook &)
+    {
+        return *this;
+    }
+
+    /**
+     * @brief Checks if the object is currently linked in a list.
+     *
+     * @return true if the hook is linked, false otherwise.
+     */
+    bool is_linked() const
+    {
+        return owner != nullptr;
+    }
+};
+
+/**
+ * @brief Hook accessor for objects deriving from dlist_hook<Tag>.
+ *
+ * @tparam T The type of the linked objects.
+ * @tparam Tag The tag of the hook base to link through.
+ */
+template <typename T, typename Tag = void> struct base_hook
+{
+    using hook_type = dlist_hook<Tag>;
+
+    static hook_type *to_hook(T *object)
+    {
+        return static_cast<hook_type *>(object);
+    }
+
+    static T *to_object(hook_type *hook)
+    {
+        return static_cast<T *>(hook);
+    }
+};
+
+/**
+ * @brief Hook accessor for objects holding a dlist_hook data member.
+ *
+ * The offset of the member is measured once, on a default-constructed T, so
+ * T must be default constructible; other types link through base_hook.
+ *
+ * @tparam T The type of the linked objects.
+ * @tparam Tag The tag of the member's hook type.
+ * @tparam Member Pointer to the hook member.
+ */
+template <typename T, typename Tag, dlist_hook<Tag> T::*Member> struct member_hook
+{
+    static_assert(std::is_default_constructible_v<T>,
+                  "member_hook measures the hook offset on a default-constructed T");
+
+    using hook_type = dlist_hook<Tag>;
+
+    static hook_type *to_hook(T *object)
+    {
+        return &(object->*Member);
+    }
+
+    static T *to_object(hook_type *hook)
+    {
+        return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - offset());
+    }
+
+  private:
+    static std::ptrdiff_t offset()
+    {
+        static const std::ptrdiff_t value = []() {
+            const T object{};
+            return reinterpret_cast<const char *>(&(object.*Member)) - reinterpret_cast<const char *>(&object);
+        }();
+
+        return value;
+    }
+};
+
+/**
+ * @brief Intrusive doubly linked list.
+ *
+ * The list links objects owned by the caller through the dlist_hook they
+ * embed: it never allocates nor frees, and removing an object it holds is
+ * O(1) from a reference to the object. The objects must stay alive and in
+ * place while linked; the list unlinks whatever it still holds when it is
+ * destroyed.
+ *
+ * The hooks form a ring through a sentinel owned by the list, so linking and
+ * unlinking never test for the ends of the list.
+ *
+ * @tparam T The type of the linked objects.
+ * @tparam Hook The hook accessor, base_hook<T, Tag> or member_hook<T, Tag, &T::member>.
+ */
+template <typename T, typename Hook = base_hook<T>> struct intrusive_dlist
+{
+  private:
+    using hook_type = typename Hook::hook_type;
+
+    size_t m_size = 0;
+    hook_type root{};
+
+    void link_before(hook_type *position, hook_type *hook);
+
+    void unlink(hook_type *hook);
+
+  public:
+    struct Iterator;
+
+    intrusive_dlist();
+    intrusive_dlist(const intrusive_dlist &) = delete;
+    intrusive_dlist &operator=(const intrusive_dlist &) = delete;
+    ~intrusive_dlist();
+
+    //  inseration / deletion
+    void insert_head(T &object);
+    void insert_tail(T &object);
+    void insert(T &object);
+    Iterator insert_before(Iterator position, T &object);
+
+    void clear();
+    void remove_head();
+    void remove_tail();
+    void remove(T &object);
+
+    // accessors
+    bool is_empty();
+    T &get_head();
+    T &get_tail();
+    const size_t &size();
+    Iterator iterator_to(T &object);
+
+    /**
+     * @brief Bidirectional iterator over the linked objects.
+     *
+     * Stays valid until the object it points to is removed.
+     */
+    struct Iterator
+    {
+        using pointer = T *;
+        using value_type = T;
+        using reference = T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+      private:
+        hook_type *current = nullptr;
+
+        friend struct intrusive_dlist;
+
+      public:
+        Iterator() = default;
+
+        Iterator(hook_type *hook) : current(hook)
+        {
+        }
+
+        T &operator*() const
+        {
+            return *Hook::to_object(current);
+        }
+
+        T *operator->() const
+        {
+            return Hook::to_object(current);
+        }
+
+        Iterator &operator++()
+        {
+            current = current->next;
+            return *this;
+        }
+
+        Iterator &operator--()
+        {
+            current = current->prev;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            current = current->next;
+            return tmp;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            current = current->prev;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return current == other.current;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return current != other.current;
+        }
+    };
+
+    /**
+     * @brief Returns an iterator pointing to the first object in the list.
+     *
+     * @return An iterator pointing to the first object in the list.
+     */
+    Iterator begin()
+    {
+        return Iterator(root.next);
+    }
+
+    /**
+     * @brief Returns an iterator referring to the past-the-end position, the
+     * sentinel. Decrementing it gives the last object.
+     *
+     * @return An iterator referring to the past-the-end position.
+     */
+    Iterator end()
+    {
+        return Iterator(&root);
+    }
+};
+
+} // namespace cxc
+
+#include "intrusive_dlist.cpp"
+
+#endif
@@ -0,0 +1,600 @@
+#ifndef CXC_MAPPED_DLIST_TPP
+#define CXC_MAPPED_DLIST_TPP
+
+#include "mapped_dlist.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cxc
+{
+
+/**
+ * @brief Opens the list stored in a file, creating an empty one if the file
+ * does not exist or is empty.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @param path The path of the file.
+ * @throws std::runtime_error if the file cannot be opened or mapped, or holds
+ * something else than a mapped_dlist of T.
+ */
+template <typename T> mapped_dlist<T>::mapped_dlist(const std::string &path)
+{
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+        throw std::runtime_error("[Error] mapped_dlist: cannot open " + path + ": " + std::strerror(errno));
+
+    bool created = false;
+
+    try
+    {
+        struct stat info;
+
+        if (::fstat(fd, &info) != 0)
+            throw std::runtime_error("[Error] mapped_dlist: cannot stat " + path + ": " + std::strerror(errno));
+
+        if (info.st_size == 0)
+        {
+            if (::ftruncate(fd, static_cast<off_t>(min_extent)) != 0)
+                throw std::runtime_error("[Error] mapped_dlist: cannot size " + path + ": " + std::strerror(errno));
+
+            created = true;
+            map(min_extent);
+
+            mapped_header &h = header();
+            std::copy(std::begin(mapped_header::magic), std::end(mapped_header::magic), h.file_magic);
+            h.version = mapped_header::current_version;
+            h.byte_order = mapped_header::byte_order_tag;
+            h.element_size = sizeof(T);
+            h.slot_size = sizeof(Slot);
+            h.size = 0;
+            h.head = 0;
+            h.tail = 0;
+            h.free_head = 0;
+            h.used = data_offset;
+        }
+        else
+        {
+            if (static_cast<size_t>(info.st_size) < data_offset)
+                throw std::runtime_error("[Error] mapped_dlist: " + path + " is not a mapped_dlist.");
+
+            map(static_cast<size_t>(info.st_size));
+
+            const mapped_header &h = header();
+
+            if (!std::equal(std::begin(mapped_header::magic), std::end(mapped_header::magic), h.file_magic) ||
+                h.version != mapped_header::current_version || h.byte_order != mapped_header::byte_order_tag)
+                throw std::runtime_error("[Error] mapped_dlist: " + path + " is not a mapped_dlist.");
+
+            if (h.element_size != sizeof(T) || h.slot_size != sizeof(Slot) || h.used > capacity)
+                throw std::runtime_error("[Error] mapped_dlist: " + path + " holds another element type.");
+        }
+    }
+    catch (...)
+    {
+        if (base != nullptr)
+            ::munmap(base, capacity);
+
+        // an empty file is left empty, not holding a header that was never written
+        if (created)
+            static_cast<void>(::ftruncate(fd, 0));
+
+        ::close(fd);
+        throw;
+    }
+}
+
+/**
+ * @brief Unmaps and closes the file. The list stays in the file.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> mapped_dlist<T>::~mapped_dlist()
+{
+    ::munmap(base, capacity);
+    ::close(fd);
+}
+
+/**
+ * @brief Returns the header at the start of the mapping.
+ *
+ * @return Reference to the header.
+ */
+template <typename T> mapped_header &mapped_dlist<T>::header()
+{
+    return *reinterpret_cast<mapped_header *>(base);
+}
+
+/**
+ * @brief Returns the slot at an offset of the file.
+ *
+ * @param offset The offset of the slot, not 0.
+ * @return Reference to the slot.
+ */
+template <typename T> typename mapped_dlist<T>::Slot &mapped_dlist<T>::slot(uint64_t offset)
+{
+    return *reinterpret_cast<Slot *>(base + offset);
+}
+
+/**
+ * @brief Maps the first bytes of the file, replacing the current mapping.
+ *
+ * The new mapping is made before the old one is dropped, so the list is left
+ * as it was if mapping fails.
+ *
+ * @param bytes The size of the mapping, the size of the file.
+ * @throws std::runtime_error if the file cannot be mapped.
+ */
+template <typename T> void mapped_dlist<T>::map(size_t bytes)
+{
+    void *memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (memory == MAP_FAILED)
+        throw std::runtime_error(std::string("[Error] mapped_dlist: cannot map the file: ") + std::strerror(errno));
+
+    if (base != nullptr)
+        ::munmap(base, capacity);
+
+    base = static_cast<char *>(memory);
+    capacity = bytes;
+}
+
+/**
+ * @brief Extends the file by one extent and maps it again.
+ *
+ * @throws std::runtime_error if the file cannot be extended or mapped, the
+ * file then keeps its old size and mapping.
+ */
+template <typename T> void mapped_dlist<T>::grow()
+{
+    size_t bytes = capacity + std::clamp(capacity, min_extent, max_extent);
+
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        throw std::runtime_error(std::string("[Error] mapped_dlist: cannot grow the file: ") + std::strerror(errno));
+
+    try
+    {
+        map(bytes);
+    }
+    catch (...)
+    {
+        static_cast<void>(::ftruncate(fd, static_cast<off_t>(capacity)));
+        throw;
+    }
+}
+
+/**
+ * @brief Stores a new element in a free slot, growing the file when every
+ * slot is in use.
+ *
+ * The element is built before the file can be remapped, so the arguments may
+ * refer to elements of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return The offset of the slot, its links left unset.
+ */
+template <typename T> template <typename... Args> uint64_t mapped_dlist<T>::create(Args &&...args)
+{
+    T value(std::forward<Args>(args)...);
+    uint64_t offset = header().free_head;
+
+    if (offset != 0)
+    {
+        header().free_head = slot(offset).next;
+    }
+    else
+    {
+        if (header().used + sizeof(Slot) > capacity)
+            grow();
+
+        offset = header().used;
+        header().used += sizeof(Slot);
+    }
+
+    std::memcpy(static_cast<void *>(&slot(offset).data), &value, sizeof(T));
+
+    return offset;
+}
+
+/**
+ * @brief Puts a slot on the free list.
+ *
+ * @param offset The offset of the slot, unlinked.
+ */
+template <typename T> void mapped_dlist<T>::destroy(uint64_t offset)
+{
+    slot(offset).prev = 0;
+    slot(offset).next = header().free_head;
+    header().free_head = offset;
+}
+
+/**
+ * @brief Links a slot before a position and counts it.
+ *
+ * @param position The slot to link before, 0 to append at the tail.
+ * @param offset The slot to link.
+ */
+template <typename T> void mapped_dlist<T>::link_before(uint64_t position, uint64_t offset)
+{
+    mapped_header &h = header();
+    uint64_t prev = position != 0 ? slot(position).prev : h.tail;
+
+    slot(offset).prev = prev;
+    slot(offset).next = position;
+
+    if (prev != 0)
+        slot(prev).next = offset;
+    else
+        h.head = offset;
+
+    if (position != 0)
+        slot(position).prev = offset;
+    else
+        h.tail = offset;
+
+    h.size++;
+}
+
+/**
+ * @brief Unlinks a slot and uncounts it.
+ *
+ * @param offset The linked slot.
+ */
+template <typename T> void mapped_dlist<T>::unlink(uint64_t offset)
+{
+    mapped_header &h = header();
+    Slot &s = slot(offset);
+
+    if (s.prev != 0)
+        slot(s.prev).next = s.next;
+    else
+        h.head = s.next;
+
+    if (s.next != 0)
+        slot(s.next).prev = s.prev;
+    else
+        h.tail = s.prev;
+
+    h.size--;
+}
+
+/**
+ * @brief Checks if a position holds an element.
+ *
+ * @param position The position to check.
+ * @return true if the position is smaller than the size.
+ */
+template <typename T> bool mapped_dlist<T>::valid_position(size_t position)
+{
+    return position < header().size;
+}
+
+/**
+ * @brief Finds the slot at a position by walking from the closer end.
+ *
+ * @param position A valid position.
+ * @return The offset of the slot.
+ */
+template <typename T> uint64_t mapped_dlist<T>::find(size_t position)
+{
+    const mapped_header &h = header();
+
+    if (position < h.size / 2)
+    {
+        uint64_t offset = h.head;
+
+        for (size_t i = 0; i < position; i++)
+            offset = slot(offset).next;
+
+        return offset;
+    }
+
+    uint64_t offset = h.tail;
+
+    for (size_t i = h.size - 1; i > position; i--)
+        offset = slot(offset).prev;
+
+    return offset;
+}
+
+/**
+ * @brief Forces the changes made so far to be written to the file.
+ *
+ * @throws std::runtime_error if the kernel reports a write error.
+ */
+template <typename T> void mapped_dlist<T>::sync()
+{
+    if (::msync(base, capacity, MS_SYNC) != 0)
+        throw std::runtime_error(std::string("[Error] mapped_dlist: cannot sync the file: ") + std::strerror(errno));
+}
+
+/**
+ * @brief Inserts a new element at the head of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void mapped_dlist<T>::insert_head(T data)
+{
+    emplace_head(std::move(data));
+}
+
+/**
+ * @brief Inserts a new element at the tail of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void mapped_dlist<T>::insert_tail(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Inserts a new element at the tail of the list, like dlist::insert.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void mapped_dlist<T>::insert(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Inserts a new element at a position, with the position rules of
+ * dlist::insert_at: 0 inserts at the head, size() - 1 appends at the tail,
+ * any other position inserts before the element found there.
+ *
+ * @param position The position at which to insert.
+ * @param data The data to be stored.
+ * @throws std::runtime_error if the position is out of bounds.
+ */
+template <typename T> void mapped_dlist<T>::insert_at(size_t position, T data)
+{
+    if (position == 0)
+    {
+        emplace_head(std::move(data));
+        return;
+    }
+
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] insert_at: position is invalid or out of bounds.");
+
+    if (position == size() - 1)
+    {
+        emplace_tail(std::move(data));
+        return;
+    }
+
+    uint64_t offset = create(std::move(data));
+    link_before(find(position), offset);
+}
+
+/**
+ * @brief Inserts a new element before the given iterator in O(1).
+ *
+ * @param position The element to insert before, end() to append.
+ * @param data The data to be stored.
+ * @return An iterator to the new element.
+ */
+template <typename T>
+typename mapped_dlist<T>::Iterator mapped_dlist<T>::insert_before(Iterator position, T data)
+{
+    uint64_t offset = create(std::move(data));
+    link_before(position.current, offset);
+
+    return Iterator(this, offset);
+}
+
+/**
+ * @brief Constructs a new element at the head of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element, valid until the file grows.
+ */
+template <typename T> template <typename... Args> T &mapped_dlist<T>::emplace_head(Args &&...args)
+{
+    uint64_t offset = create(std::forward<Args>(args)...);
+    link_before(header().head, offset);
+
+    return slot(offset).data;
+}
+
+/**
+ * @brief Constructs a new element at the tail of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ * @return Reference to the new element, valid until the file grows.
+ */
+template <typename T> template <typename... Args> T &mapped_dlist<T>::emplace_tail(Args &&...args)
+{
+    uint64_t offset = create(std::forward<Args>(args)...);
+    link_before(0, offset);
+
+    return slot(offset).data;
+}
+
+/**
+ * @brief Removes every element. The file keeps its size, its slots are
+ * handed out again from the start.
+ */
+template <typename T> void mapped_dlist<T>::clear()
+{
+    mapped_header &h = header();
+
+    h.size = 0;
+    h.head = 0;
+    h.tail = 0;
+    h.free_head = 0;
+    h.used = data_offset;
+}
+
+/**
+ * @brief Removes the element at the head of the list, if any.
+ */
+template <typename T> void mapped_dlist<T>::remove_head()
+{
+    if (is_empty())
+        return;
+
+    uint64_t offset = header().head;
+    unlink(offset);
+    destroy(offset);
+}
+
+/**
+ * @brief Removes the element at the tail of the list, if any.
+ */
+template <typename T> void mapped_dlist<T>::remove_tail()
+{
+    if (is_empty())
+        return;
+
+    uint64_t offset = header().tail;
+    unlink(offset);
+    destroy(offset);
+}
+
+/**
+ * @brief Removes the element at a position.
+ *
+ * @param position The position of the element.
+ * @throws std::runtime_error if the position is out of bounds.
+ */
+template <typename T> void mapped_dlist<T>::remove_at(size_t position)
+{
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] remove_at: position is invalid or out of bounds.");
+
+    uint64_t offset = find(position);
+    unlink(offset);
+    destroy(offset);
+}
+
+/**
+ * @brief Removes the element at the given iterator in O(1).
+ *
+ * @param position The element to remove, not end().
+ * @return An iterator to the element following the removed one.
+ * @throws std::runtime_error if position is end().
+ */
+template <typename T> typename mapped_dlist<T>::Iterator mapped_dlist<T>::erase(Iterator position)
+{
+    if (position.current == 0)
+        throw std::runtime_error("[Error] erase: cannot erase end().");
+
+    uint64_t next = slot(position.current).next;
+
+    unlink(position.current);
+    destroy(position.current);
+
+    return Iterator(this, next);
+}
+
+/**
+ * @brief Replaces the element at a position.
+ *
+ * @param position The position of the element.
+ * @param data The new data.
+ * @throws std::runtime_error if the position is out of bounds.
+ */
+template <typename T> void mapped_dlist<T>::change(size_t position, T data)
+{
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] change: position is invalid or out of bounds");
+
+    slot(find(position)).data = std::move(data);
+}
+
+/**
+ * @brief Checks if the list is empty.
+ *
+ * @return true if the list is empty, false otherwise.
+ */
+template <typename T> bool mapped_dlist<T>::is_empty()
+{
+    return header().head == 0;
+}
+
+/**
+ * @brief Returns a reference to the element at the head of the list.
+ *
+ * If the list is empty, a std::runtime_error is thrown.
+ *
+ * @return A const reference to the head element.
+ */
+template <typename T> const T &mapped_dlist<T>::get_head()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access head data.");
+
+    return slot(header().head).data;
+}
+
+/**
+ * @brief Returns a reference to the element at the tail of the list.
+ *
+ * If the list is empty, a std::runtime_error is thrown.
+ *
+ * @return A const reference to the tail element.
+ */
+template <typename T> const T &mapped_dlist<T>::get_tail()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access tail data.");
+
+    return slot(header().tail).data;
+}
+
+/**
+ * @brief Returns the number of elements in the list.
+ *
+ * @return The size of the list, as stored in the file.
+ */
+template <typename T> size_t mapped_dlist<T>::size()
+{
+    return static_cast<size_t>(header().size);
+}
+
+/**
+ * @brief Returns the element at a position.
+ *
+ * @param position The position of the element.
+ * @return Reference to the element, valid until the file grows.
+ * @throws std::runtime_error if the position is out of bounds.
+ */
+template <typename T> T &mapped_dlist<T>::get(size_t position)
+{
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] get: position is invalid or out of bounds.");
+
+    return slot(find(position)).data;
+}
+
+/**
+ * @brief Reverses the order of the elements by swapping every slot's links.
+ */
+template <typename T> void mapped_dlist<T>::reverse()
+{
+    mapped_header &h = header();
+
+    for (uint64_t offset = h.head; offset != 0;)
+    {
+        Slot &s = slot(offset);
+        std::swap(s.prev, s.next);
+        offset = s.prev;
+    }
+
+    std::swap(h.head, h.tail);
+}
+
+} // namespace cxc
+
+#endif
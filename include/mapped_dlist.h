@@ -0,0 +1,238 @@
+#ifndef CXC_MAPPED_DLIST_H
+#define CXC_MAPPED_DLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+
+namespace cxc
+{
+
+/**
+ * @brief Header at the start of a mapped_dlist file.
+ *
+ * Links are byte offsets from the start of the file, 0 being the null link,
+ * so the file can be mapped at any address.
+ */
+struct mapped_header
+{
+    static constexpr char magic[8] = {'C', 'X', 'C', 'M', 'D', 'L', 'S', 'T'};
+    static constexpr uint32_t current_version = 1;
+    static constexpr uint32_t byte_order_tag = 0x01020304;
+
+    char file_magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t element_size;
+    uint64_t slot_size;
+    uint64_t size;
+    uint64_t head;
+    uint64_t tail;
+    uint64_t free_head;
+    // end of the slots handed out so far, the rest of the file is spare
+    uint64_t used;
+};
+
+/**
+ * @brief Doubly linked list living in a memory-mapped file.
+ *
+ * Nodes are slots of the file linked by offsets instead of pointers. Opening
+ * an existing file maps it and the list can be iterated right away, without
+ * any deserialization. The file grows by extents (doubling up to 64 MiB at a
+ * time) and removed slots are reused first.
+ *
+ * Growing remaps the file: references and pointers to elements are then
+ * invalidated, while iterators, which hold offsets, stay valid until their
+ * element is removed. The mapping is shared, so changes are seen by the next
+ * list opening the file even before they reach the disk; sync() forces them
+ * out. The file is not crash-consistent: a machine crash between two syncs
+ * can leave it damaged. POSIX only, and a file must not be opened by two
+ * lists at once.
+ *
+ * @tparam T The type of elements stored in the list, trivially copyable and
+ * stored in the machine's byte order.
+ */
+template <typename T> struct mapped_dlist
+{
+    static_assert(std::is_trivially_copyable_v<T>, "mapped_dlist stores its elements as raw bytes in the file");
+
+    static constexpr size_t min_extent = size_t(1) << 16;
+    static constexpr size_t max_extent = size_t(1) << 26;
+
+  private:
+    struct Slot
+    {
+        uint64_t prev;
+        uint64_t next;
+        T data;
+    };
+
+    // the header padded so that the first slot is aligned
+    static constexpr size_t data_offset = (sizeof(mapped_header) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    int fd = -1;
+    char *base = nullptr;
+    size_t capacity = 0;
+
+    mapped_header &header();
+
+    Slot &slot(uint64_t offset);
+
+    void map(size_t bytes);
+
+    void grow();
+
+    template <typename... Args> uint64_t create(Args &&...args);
+
+    void destroy(uint64_t offset);
+
+    void link_before(uint64_t position, uint64_t offset);
+
+    void unlink(uint64_t offset);
+
+    bool valid_position(size_t position);
+
+    uint64_t find(size_t position);
+
+  public:
+    struct Iterator;
+
+    explicit mapped_dlist(const std::string &path);
+    mapped_dlist(const mapped_dlist &) = delete;
+    mapped_dlist &operator=(const mapped_dlist &) = delete;
+    ~mapped_dlist();
+
+    void sync();
+
+    //  inseration / deletion
+    void insert_head(T data);
+    void insert_tail(T data);
+    void insert(T data);
+    void insert_at(size_t position, T data);
+    Iterator insert_before(Iterator position, T data);
+
+    template <typename... Args> T &emplace_head(Args &&...args);
+    template <typename... Args> T &emplace_tail(Args &&...args);
+
+    void clear();
+    void remove_head();
+    void remove_tail();
+    void remove_at(size_t position);
+    Iterator erase(Iterator position);
+
+    // modify
+    void change(size_t position, T data);
+
+    // accessors
+    bool is_empty();
+    const T &get_head();
+    const T &get_tail();
+    size_t size();
+    T &get(size_t position);
+
+    // misc
+    void reverse();
+
+    /**
+     * @brief Bidirectional iterator over a mapped_dlist.
+     *
+     * Holds the offset of its slot, so it survives the remapping done when
+     * the file grows. end() can be decremented to reach the last element.
+     */
+    struct Iterator
+    {
+        using pointer = T *;
+        using value_type = T;
+        using reference = T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+      private:
+        mapped_dlist *list = nullptr;
+        uint64_t current = 0;
+
+        friend struct mapped_dlist;
+
+      public:
+        Iterator() = default;
+
+        Iterator(mapped_dlist *_list, uint64_t offset) : list(_list), current(offset)
+        {
+        }
+
+        T &operator*() const
+        {
+            return list->slot(current).data;
+        }
+
+        T *operator->() const
+        {
+            return &list->slot(current).data;
+        }
+
+        Iterator &operator++()
+        {
+            current = list->slot(current).next;
+            return *this;
+        }
+
+        Iterator &operator--()
+        {
+            current = current != 0 ? list->slot(current).prev : list->header().tail;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return current == other.current;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return current != other.current;
+        }
+    };
+
+    /**
+     * @brief Returns an iterator pointing to the first element in the list.
+     *
+     * @return An iterator pointing to the first element in the list.
+     */
+    Iterator begin()
+    {
+        return Iterator(this, header().head);
+    }
+
+    /**
+     * @brief Returns an iterator referring to the past-the-end element in the
+     * list.
+     *
+     * @return An iterator referring to the past-the-end element in the list.
+     */
+    Iterator end()
+    {
+        return Iterator(this, 0);
+    }
+};
+
+} // namespace cxc
+
+#include "mapped_dlist.cpp"
+
+#endif
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
 namespace cxc
 {
 
@@ -9,14 +15,32 @@ template <typename T> struct Node
     Node *prev;
     Node *next;
 
-    Node(T _data, Node *_prev = nullptr, Node *_next = nullptr) : data(_data), prev(_prev), next(_next)
+    Node(T _data, Node *_prev = nullptr, Node *_next = nullptr) : data(std::move(_data)), prev(_prev), next(_next)
+    {
+    }
+
+    // constructs the data in place from the given arguments
+    template <typename... Args>
+    Node(std::in_place_t, Args &&...args) : data(std::forward<Args>(args)...), prev(nullptr), next(nullptr)
     {
     }
 
     static Node *create(T data, Node *prev = nullptr, Node *next = nullptr)
     {
-        return new Node(data, prev, next);
+        return new Node(std::move(data), prev, next);
     }
 };
 
-} // namespace cxc
\ No newline at end of file
+// asks the CPU to start loading a node into the cache ahead of its use
+template <typename T> inline void prefetch(const Node<T> *node)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(node);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(reinterpret_cast<const char *>(node), _MM_HINT_T0);
+#else
+    (void)node;
+#endif
+}
+
+} // namespace cxc
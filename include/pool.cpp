@@ -0,0 +1,639 @@
+#ifndef CXC_POOL_TPP
+#define CXC_POOL_TPP
+
+#include "pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Allocates an unlinked node with new.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T> template <typename... Args> Node<T> *heap_allocator<T>::create(Args &&...args)
+{
+    return new Node<T>(std::in_place, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Allocates an unlinked node with new, like create(). Nodes allocated
+ * back to back usually end up next to each other in the heap.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T> template <typename... Args> Node<T> *heap_allocator<T>::create_contiguous(Args &&...args)
+{
+    return create(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Deletes a node created by create() or Node<T>::create.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param node The node to delete.
+ */
+template <typename T> void heap_allocator<T>::destroy(Node<T> *node)
+{
+    delete node;
+}
+
+/**
+ * @brief Heap nodes can only be freed one by one.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Always false, the caller has to destroy every node itself.
+ */
+template <typename T> bool heap_allocator<T>::release()
+{
+    return false;
+}
+
+/**
+ * @brief Heap allocators hold no state, so none is shared.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Always true.
+ */
+template <typename T> bool heap_allocator<T>::unique() const
+{
+    return true;
+}
+
+/**
+ * @brief Returns the heap bytes held for the given number of live nodes.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param nodes The number of nodes created and not destroyed yet.
+ * @return One node size per live node, malloc overhead excluded.
+ */
+template <typename T> size_t heap_allocator<T>::footprint(size_t nodes) const
+{
+    return nodes * sizeof(Node<T>);
+}
+
+/**
+ * @brief Allocates a slab with the global operator new.
+ *
+ * @param bytes The size of the slab, left as is.
+ * @param alignment The alignment of the slab.
+ * @return Pointer to the slab.
+ */
+inline void *heap_slabs::allocate(size_t &bytes, size_t alignment)
+{
+    return ::operator new(bytes, std::align_val_t{alignment});
+}
+
+/**
+ * @brief Frees a slab allocated by allocate().
+ *
+ * @param memory The slab.
+ * @param alignment The alignment it was allocated with.
+ */
+inline void heap_slabs::deallocate(void *memory, size_t, size_t alignment)
+{
+    ::operator delete(memory, std::align_val_t{alignment});
+}
+
+/**
+ * @brief Heap slabs are not placed on huge pages on purpose.
+ *
+ * @return Always 0.
+ */
+inline size_t heap_slabs::huge_page_bytes(const std::vector<std::pair<const void *, size_t>> &)
+{
+    return 0;
+}
+
+/**
+ * @brief Shares the arena of another pool, creating it if needed.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param other The pool to share the arena with.
+ */
+template <typename T, typename Source> node_pool<T, Source>::node_pool(const node_pool &other) : arena(other.shared())
+{
+    arena->refs++;
+}
+
+/**
+ * @brief Takes over the handle of another pool, which is left without an
+ * arena, as a new pool.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param other The pool to take the arena from.
+ */
+template <typename T, typename Source>
+node_pool<T, Source>::node_pool(node_pool &&other) noexcept : arena(other.arena)
+{
+    other.arena = nullptr;
+}
+
+/**
+ * @brief Drops the current arena and shares the arena of another pool.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param other The pool to share the arena with.
+ * @return Reference to this pool.
+ */
+template <typename T, typename Source> node_pool<T, Source> &node_pool<T, Source>::operator=(const node_pool &other)
+{
+    Arena *next = other.shared();
+    next->refs++;
+
+    drop();
+    arena = next;
+
+    return *this;
+}
+
+/**
+ * @brief Drops the current arena and takes over the handle of another pool,
+ * which is left without an arena, as a new pool.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param other The pool to take the arena from.
+ * @return Reference to this pool.
+ */
+template <typename T, typename Source>
+node_pool<T, Source> &node_pool<T, Source>::operator=(node_pool &&other) noexcept
+{
+    if (this != &other)
+    {
+        drop();
+        arena = other.arena;
+        other.arena = nullptr;
+    }
+
+    return *this;
+}
+
+/**
+ * @brief Releases this handle on the arena.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ */
+template <typename T, typename Source> node_pool<T, Source>::~node_pool()
+{
+    drop();
+}
+
+/**
+ * @brief Returns the arena of the pool, allocating it on first use.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @return Pointer to the arena.
+ */
+template <typename T, typename Source> typename node_pool<T, Source>::Arena *node_pool<T, Source>::shared() const
+{
+    if (arena == nullptr)
+        arena = new Arena;
+
+    return arena;
+}
+
+/**
+ * @brief Releases this handle on the arena, freeing every slab with the last
+ * one. Node destructors are not run, the owning lists clear themselves first.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ */
+template <typename T, typename Source> void node_pool<T, Source>::drop()
+{
+    if (arena == nullptr || --arena->refs > 0)
+    {
+        arena = nullptr;
+        return;
+    }
+
+    while (arena->slabs != nullptr)
+    {
+        Slab *next = arena->slabs->next;
+        free_slab(arena->slabs);
+        arena->slabs = next;
+    }
+
+    delete arena;
+    arena = nullptr;
+}
+
+/**
+ * @brief Returns the first node slot that follows the slab header.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param slab The slab to look into.
+ * @return Pointer to the first slot of the slab.
+ */
+template <typename T, typename Source> typename node_pool<T, Source>::Slot *node_pool<T, Source>::first_slot(Slab *slab)
+{
+    return reinterpret_cast<Slot *>(reinterpret_cast<unsigned char *>(slab) + header_size);
+}
+
+/**
+ * @brief Allocates a new slab, twice as large as the previous one up to
+ * max_slab nodes, and makes it the one new nodes are carved from. The source
+ * may hand out more memory than asked for, the extra becoming more slots.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param state The arena to grow.
+ */
+template <typename T, typename Source> void node_pool<T, Source>::grow(Arena *state)
+{
+    size_t bytes = header_size + state->next_capacity * sizeof(Slot);
+    void *memory = Source::allocate(bytes, alignment);
+
+    Slab *slab = new (memory) Slab{state->slabs, (bytes - header_size) / sizeof(Slot), bytes};
+    state->slabs = slab;
+
+    state->cursor = first_slot(slab);
+    state->cursor_end = state->cursor + slab->capacity;
+
+    if (state->next_capacity < max_slab)
+        state->next_capacity = std::min(std::max(state->next_capacity, slab->capacity) * 2, max_slab);
+}
+
+/**
+ * @brief Returns the memory of a slab to its source.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param slab The slab to free.
+ */
+template <typename T, typename Source> void node_pool<T, Source>::free_slab(Slab *slab)
+{
+    Source::deallocate(slab, slab->bytes, alignment);
+}
+
+/**
+ * @brief Constructs an unlinked node in a recycled slot, or carves a new one
+ * from the current slab.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T, typename Source> template <typename... Args> Node<T> *node_pool<T, Source>::create(Args &&...args)
+{
+    Arena *state = shared();
+    Slot *slot;
+
+    if (state->free_list != nullptr)
+    {
+        slot = state->free_list;
+        state->free_list = slot->next;
+    }
+    else
+    {
+        if (state->cursor == state->cursor_end)
+            grow(state);
+
+        slot = state->cursor++;
+    }
+
+    try
+    {
+        return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->next = state->free_list;
+        state->free_list = slot;
+        throw;
+    }
+}
+
+/**
+ * @brief Constructs an unlinked node in a slot never used before, carved
+ * from the current slab, so that nodes created one after the other are
+ * adjacent. Recycled slots are left on the free list.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T, typename Source>
+template <typename... Args>
+Node<T> *node_pool<T, Source>::create_contiguous(Args &&...args)
+{
+    Arena *state = shared();
+
+    if (state->cursor == state->cursor_end)
+        grow(state);
+
+    Slot *slot = state->cursor++;
+
+    try
+    {
+        return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->next = state->free_list;
+        state->free_list = slot;
+        throw;
+    }
+}
+
+/**
+ * @brief Destroys a node and puts its slot on the free list.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param node The node to destroy, it must have been created by this pool or
+ * a pool sharing its arena.
+ */
+template <typename T, typename Source> void node_pool<T, Source>::destroy(Node<T> *node)
+{
+    node->~Node<T>();
+
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = arena->free_list;
+    arena->free_list = slot;
+}
+
+/**
+ * @brief Drops every node of the pool at once.
+ *
+ * Older slabs are freed and the newest, largest slab is kept so that refilling
+ * the list does not go back to the global allocator. Node destructors are not
+ * run.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @return true if the nodes were dropped, false if the arena is shared with
+ * another pool and the caller has to destroy its nodes one by one.
+ */
+template <typename T, typename Source> bool node_pool<T, Source>::release()
+{
+    if (arena == nullptr)
+        return true;
+
+    if (arena->refs > 1)
+        return false;
+
+    arena->free_list = nullptr;
+
+    if (arena->slabs == nullptr)
+        return true;
+
+    Slab *ptr = arena->slabs->next;
+
+    while (ptr != nullptr)
+    {
+        Slab *next = ptr->next;
+        free_slab(ptr);
+        ptr = next;
+    }
+
+    arena->slabs->next = nullptr;
+    arena->cursor = first_slot(arena->slabs);
+    arena->cursor_end = arena->cursor + arena->slabs->capacity;
+
+    return true;
+}
+
+/**
+ * @brief Checks if no other pool shares the arena.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @return true if this handle is the only one on its arena, or has none.
+ */
+template <typename T, typename Source> bool node_pool<T, Source>::unique() const
+{
+    return arena == nullptr || arena->refs == 1;
+}
+
+/**
+ * @brief Returns the bytes held by the arena, whichever handle created the
+ * nodes in it.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @return The total size of the slabs.
+ */
+template <typename T, typename Source> size_t node_pool<T, Source>::footprint(size_t) const
+{
+    size_t bytes = 0;
+
+    if (arena == nullptr)
+        return bytes;
+
+    for (Slab *slab = arena->slabs; slab != nullptr; slab = slab->next)
+        bytes += slab->bytes;
+
+    return bytes;
+}
+
+/**
+ * @brief Returns the bytes of the arena that the kernel currently backs with
+ * huge pages, as reported by the slab source.
+ *
+ * Compared with footprint(), it tells how much of the nodes are reached
+ * through huge page TLB entries.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @return The bytes of the slabs on huge pages.
+ */
+template <typename T, typename Source> size_t node_pool<T, Source>::huge_page_bytes() const
+{
+    if (arena == nullptr)
+        return 0;
+
+    std::vector<std::pair<const void *, size_t>> slabs;
+
+    for (Slab *slab = arena->slabs; slab != nullptr; slab = slab->next)
+        slabs.emplace_back(slab, slab->bytes);
+
+    return Source::huge_page_bytes(slabs);
+}
+
+/**
+ * @brief Checks if two pools share the same arena, in which case nodes of one
+ * can be destroyed by the other.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source The source of the slabs.
+ * @param other The pool to compare with.
+ * @return true if both pools share an arena, false otherwise.
+ */
+template <typename T, typename Source> bool node_pool<T, Source>::operator==(const node_pool &other) const
+{
+    return arena != nullptr && arena == other.arena;
+}
+
+/**
+ * @brief Checks if a node sits in one of the inline slots.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @param node The node.
+ * @return true for an inline node, false for a heap node.
+ */
+template <typename T, size_t N> bool inline_pool<T, N>::owns(const Node<T> *node) const
+{
+    const void *address = node;
+    return !std::less<const void *>()(address, slots) && std::less<const void *>()(address, slots + N);
+}
+
+/**
+ * @brief Checks if the next node created would go to an inline slot.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @return true if an inline slot is free, false if the next node spills.
+ */
+template <typename T, size_t N> bool inline_pool<T, N>::has_free_slot() const
+{
+    return free_list != nullptr || carved < N;
+}
+
+/**
+ * @brief Constructs an unlinked node in a free inline slot, or on the heap
+ * when every inline slot is taken.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T, size_t N> template <typename... Args> Node<T> *inline_pool<T, N>::create(Args &&...args)
+{
+    Slot *slot = nullptr;
+
+    if (free_list != nullptr)
+    {
+        slot = free_list;
+        free_list = slot->next;
+    }
+    else if (carved < N)
+    {
+        slot = &slots[carved++];
+    }
+
+    if (slot == nullptr)
+    {
+        Node<T> *node = new Node<T>(std::in_place, std::forward<Args>(args)...);
+        spilled++;
+        return node;
+    }
+
+    try
+    {
+        return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->next = free_list;
+        free_list = slot;
+        throw;
+    }
+}
+
+/**
+ * @brief Same as create(): the inline slots are contiguous already.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T, size_t N>
+template <typename... Args>
+Node<T> *inline_pool<T, N>::create_contiguous(Args &&...args)
+{
+    return create(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Destroys a node, freeing its inline slot or its heap memory.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @param node The node to destroy.
+ */
+template <typename T, size_t N> void inline_pool<T, N>::destroy(Node<T> *node)
+{
+    if (!owns(node))
+    {
+        delete node;
+        spilled--;
+        return;
+    }
+
+    node->~Node<T>();
+
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = free_list;
+    free_list = slot;
+}
+
+/**
+ * @brief Drops every node at once when all of them are inline.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @return true if the slots were reset, false if heap nodes are alive and
+ * the caller has to destroy every node itself.
+ */
+template <typename T, size_t N> bool inline_pool<T, N>::release()
+{
+    if (spilled != 0)
+        return false;
+
+    free_list = nullptr;
+    carved = 0;
+
+    return true;
+}
+
+/**
+ * @brief An inline_pool is never shared.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @return Always true.
+ */
+template <typename T, size_t N> bool inline_pool<T, N>::unique() const
+{
+    return true;
+}
+
+/**
+ * @brief Returns the bytes held for nodes: the inline slots, which are part
+ * of the list object, and the heap nodes.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ * @return The size of the slots plus one node size per heap node.
+ */
+template <typename T, size_t N> size_t inline_pool<T, N>::footprint(size_t) const
+{
+    return sizeof(slots) + spilled * sizeof(Node<T>);
+}
+
+} // namespace cxc
+
+#endif
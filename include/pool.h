@@ -0,0 +1,213 @@
+#ifndef CXC_POOL_H
+#define CXC_POOL_H
+
+#include "node.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Allocator policy that creates every node with its own new / delete.
+ *
+ * This is how dlist allocated nodes before allocator policies existed, and it
+ * is the policy to use when nodes made with Node<T>::create are handed to the
+ * list.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ */
+template <typename T> struct heap_allocator
+{
+    template <typename... Args> Node<T> *create(Args &&...args);
+
+    template <typename... Args> Node<T> *create_contiguous(Args &&...args);
+
+    void destroy(Node<T> *node);
+
+    bool release();
+
+    bool unique() const;
+
+    size_t footprint(size_t nodes) const;
+
+    bool operator==(const heap_allocator &) const
+    {
+        return true;
+    }
+};
+
+/**
+ * @brief Slab source of node_pool taking slabs from the global operator new.
+ *
+ * A slab source provides the memory node_pool carves its nodes from: its
+ * allocate() may round the requested size up, deallocate() gets back the
+ * rounded size, and min_slab / max_slab bound the slab sizes in nodes.
+ * huge_page_bytes() gets every slab of an arena at once, as (address, size)
+ * pairs, so that a source can inspect them all with a single system query.
+ */
+struct heap_slabs
+{
+    static constexpr size_t min_slab = 64;
+    static constexpr size_t max_slab = 8192;
+
+    static void *allocate(size_t &bytes, size_t alignment);
+
+    static void deallocate(void *memory, size_t bytes, size_t alignment);
+
+    static size_t huge_page_bytes(const std::vector<std::pair<const void *, size_t>> &slabs);
+};
+
+/**
+ * @brief Slab allocator policy for Node<T>.
+ *
+ * Nodes are carved from large blocks (slabs) that grow geometrically, removed
+ * nodes are pushed onto a free list and recycled by the next insertion, and
+ * release() drops every node at once without visiting them.
+ *
+ * A node_pool is a handle on a reference-counted arena: copies share the same
+ * slabs, so lists created with copies of one pool can exchange nodes in O(1)
+ * (see dlist::splice). The arena is only allocated by the first node, and a
+ * shared arena is never released wholesale. Pools are not thread-safe.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam Source Where slabs come from, heap_slabs or huge_page_slabs.
+ */
+template <typename T, typename Source = heap_slabs> struct node_pool
+{
+    // number of nodes in the first slab, doubled for every following slab
+    static constexpr size_t min_slab = Source::min_slab;
+    static constexpr size_t max_slab = Source::max_slab;
+
+  private:
+    struct Slab
+    {
+        Slab *next;
+        size_t capacity;
+        size_t bytes;
+    };
+
+    union Slot {
+        Slot *next;
+        alignas(Node<T>) unsigned char storage[sizeof(Node<T>)];
+    };
+
+    static constexpr size_t alignment = alignof(Slot) > alignof(Slab) ? alignof(Slot) : alignof(Slab);
+    static constexpr size_t header_size = (sizeof(Slab) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    struct Arena
+    {
+        Slab *slabs = nullptr;
+        Slot *free_list = nullptr;
+        Slot *cursor = nullptr;
+        Slot *cursor_end = nullptr;
+        size_t next_capacity = min_slab;
+        size_t refs = 1;
+    };
+
+    // created on first use, so that copies made before any allocation still
+    // end up sharing it
+    mutable Arena *arena = nullptr;
+
+    Arena *shared() const;
+
+    void drop();
+
+    static Slot *first_slot(Slab *slab);
+
+    static void grow(Arena *state);
+
+    static void free_slab(Slab *slab);
+
+  public:
+    node_pool() = default;
+    node_pool(const node_pool &other);
+    node_pool(node_pool &&other) noexcept;
+    node_pool &operator=(const node_pool &other);
+    node_pool &operator=(node_pool &&other) noexcept;
+    ~node_pool();
+
+    template <typename... Args> Node<T> *create(Args &&...args);
+
+    template <typename... Args> Node<T> *create_contiguous(Args &&...args);
+
+    void destroy(Node<T> *node);
+
+    bool release();
+
+    bool unique() const;
+
+    size_t footprint(size_t nodes) const;
+
+    size_t huge_page_bytes() const;
+
+    bool operator==(const node_pool &other) const;
+};
+
+/**
+ * @brief Allocator policy keeping the first N nodes inside the list object.
+ *
+ * Nodes go to N slots stored inline, so a list that never holds more than N
+ * elements never touches the heap; further nodes are allocated with new
+ * until inline slots free up again. The slots live in the pool, so a copy is
+ * a new, empty pool: lists never share an inline_pool, and splicing between
+ * them moves the elements one by one.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @tparam N The number of inline slots.
+ */
+template <typename T, size_t N> struct inline_pool
+{
+    static_assert(N > 0, "inline_pool needs at least one inline slot");
+
+  private:
+    union Slot {
+        Slot *next;
+        alignas(Node<T>) unsigned char storage[sizeof(Node<T>)];
+    };
+
+    Slot slots[N];
+    Slot *free_list = nullptr;
+    // slots handed out at least once, from the first
+    size_t carved = 0;
+    // live nodes allocated on the heap
+    size_t spilled = 0;
+
+  public:
+    inline_pool() = default;
+
+    inline_pool(const inline_pool &) : inline_pool()
+    {
+    }
+
+    inline_pool &operator=(const inline_pool &) = delete;
+
+    template <typename... Args> Node<T> *create(Args &&...args);
+
+    template <typename... Args> Node<T> *create_contiguous(Args &&...args);
+
+    void destroy(Node<T> *node);
+
+    bool release();
+
+    bool unique() const;
+
+    size_t footprint(size_t nodes) const;
+
+    bool owns(const Node<T> *node) const;
+
+    bool has_free_slot() const;
+
+    bool operator==(const inline_pool &other) const
+    {
+        return this == &other;
+    }
+};
+
+} // namespace cxc
+
+#include "pool.cpp"
+
+#endif
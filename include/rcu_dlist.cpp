@@ -0,0 +1,307 @@
+#ifndef CXC_RCU_DLIST_TPP
+#define CXC_RCU_DLIST_TPP
+
+#include "rcu_dlist.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Frees the nodes of the list and the removed ones. No other thread
+ * may use the list anymore.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> rcu_dlist<T>::~rcu_dlist()
+{
+    Node<T> *node = head.load(std::memory_order_relaxed);
+
+    while (node != nullptr)
+    {
+        Node<T> *next = node->next;
+        delete node;
+        node = next;
+    }
+
+    for (Retired &entry : retired)
+        delete entry.node;
+}
+
+/**
+ * @brief Gives atomic access to the next link of a node.
+ *
+ * @param field The next field of a node.
+ * @return An atomic reference to the field.
+ */
+template <typename T> std::atomic_ref<Node<T> *> rcu_dlist<T>::link(Node<T> *&field)
+{
+    return std::atomic_ref<Node<T> *>(field);
+}
+
+/**
+ * @brief Publishes a node at the head of the list.
+ *
+ * @param node The node, not reachable by readers yet.
+ */
+template <typename T> void rcu_dlist<T>::push_head(Node<T> *node)
+{
+    Node<T> *first = head.load(std::memory_order_relaxed);
+
+    node->prev = nullptr;
+    node->next = first;
+
+    head.store(node, std::memory_order_release);
+
+    if (first != nullptr)
+        first->prev = node;
+    else
+        tail = node;
+
+    m_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Publishes a node at the tail of the list.
+ *
+ * @param node The node, not reachable by readers yet.
+ */
+template <typename T> void rcu_dlist<T>::push_tail(Node<T> *node)
+{
+    node->prev = tail;
+    node->next = nullptr;
+
+    if (tail != nullptr)
+        link(tail->next).store(node, std::memory_order_release);
+    else
+        head.store(node, std::memory_order_release);
+
+    tail = node;
+    m_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Unlinks a node and retires it, freeing the retired nodes no reader
+ * can reach once there are enough of them.
+ *
+ * The node keeps its next link, readers standing on it go on from there.
+ *
+ * @param node The node to remove.
+ */
+template <typename T> void rcu_dlist<T>::unlink(Node<T> *node)
+{
+    Node<T> *next = link(node->next).load(std::memory_order_relaxed);
+
+    if (node->prev != nullptr)
+        link(node->prev->next).store(next, std::memory_order_release);
+    else
+        head.store(next, std::memory_order_release);
+
+    if (next != nullptr)
+        next->prev = node->prev;
+    else
+        tail = node->prev;
+
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+
+    // the unlinking stores must be visible before the tag is read: otherwise
+    // another writer of the domain could advance the epoch in between, and a
+    // reader publishing the newer epoch still reach the node
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    retired.push_back(Retired{node, epoch_domain::instance().current()});
+
+    if (retired.size() >= reclaim_threshold)
+        reclaim();
+}
+
+/**
+ * @brief Inserts an element at the head of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void rcu_dlist<T>::insert_head(T data)
+{
+    emplace_head(std::move(data));
+}
+
+/**
+ * @brief Inserts an element at the tail of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T> void rcu_dlist<T>::insert_tail(T data)
+{
+    emplace_tail(std::move(data));
+}
+
+/**
+ * @brief Constructs an element in place at the head of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ */
+template <typename T> template <typename... Args> void rcu_dlist<T>::emplace_head(Args &&...args)
+{
+    push_head(new Node<T>(std::in_place, std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Constructs an element in place at the tail of the list.
+ *
+ * @param args The arguments forwarded to the constructor of T.
+ */
+template <typename T> template <typename... Args> void rcu_dlist<T>::emplace_tail(Args &&...args)
+{
+    push_tail(new Node<T>(std::in_place, std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Removes the element at the head of the list.
+ *
+ * @throws std::runtime_error if the list is empty.
+ */
+template <typename T> void rcu_dlist<T>::remove_head()
+{
+    Node<T> *first = head.load(std::memory_order_relaxed);
+
+    if (first == nullptr)
+        throw std::runtime_error("[Error] remove_head: list is empty.");
+
+    unlink(first);
+}
+
+/**
+ * @brief Removes the element at the tail of the list.
+ *
+ * @throws std::runtime_error if the list is empty.
+ */
+template <typename T> void rcu_dlist<T>::remove_tail()
+{
+    if (tail == nullptr)
+        throw std::runtime_error("[Error] remove_tail: list is empty.");
+
+    unlink(tail);
+}
+
+/**
+ * @brief Removes every element equal to a value.
+ *
+ * @param value The value to remove.
+ * @return The number of removed elements.
+ */
+template <typename T> size_t rcu_dlist<T>::remove(const T &value)
+{
+    return remove_if([&value](const T &data) { return data == value; });
+}
+
+/**
+ * @brief Removes every element satisfying a predicate.
+ *
+ * @tparam Pred The type of the predicate.
+ * @param pred Returns true for the elements to remove.
+ * @return The number of removed elements.
+ */
+template <typename T> template <typename Pred> size_t rcu_dlist<T>::remove_if(Pred pred)
+{
+    size_t removed = 0;
+    Node<T> *node = head.load(std::memory_order_relaxed);
+
+    while (node != nullptr)
+    {
+        Node<T> *next = link(node->next).load(std::memory_order_relaxed);
+
+        if (pred(std::as_const(node->data)))
+        {
+            unlink(node);
+            removed++;
+        }
+
+        node = next;
+    }
+
+    return removed;
+}
+
+/**
+ * @brief Removes every element of the list.
+ */
+template <typename T> void rcu_dlist<T>::clear()
+{
+    while (tail != nullptr)
+        unlink(tail);
+}
+
+/**
+ * @brief Frees the removed nodes that no reader can reach anymore.
+ *
+ * Called by the writer every reclaim_threshold removals; calling it earlier
+ * gives memory back sooner.
+ */
+template <typename T> void rcu_dlist<T>::reclaim()
+{
+    uint64_t oldest = epoch_domain::instance().advance();
+    size_t kept = 0;
+
+    for (Retired &entry : retired)
+    {
+        if (entry.epoch < oldest)
+            delete entry.node;
+        else
+            retired[kept++] = entry;
+    }
+
+    retired.resize(kept);
+}
+
+/**
+ * @brief Checks if the list is empty at the time of the call.
+ *
+ * @return true if the list is empty, false otherwise.
+ */
+template <typename T> bool rcu_dlist<T>::is_empty()
+{
+    return head.load(std::memory_order_acquire) == nullptr;
+}
+
+/**
+ * @brief Returns the number of elements at the time of the call.
+ *
+ * @return The size of the list.
+ */
+template <typename T> size_t rcu_dlist<T>::size()
+{
+    return m_size.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns an iterator to the first element, entering a read section
+ * that lasts as long as the iterator or its copies.
+ *
+ * @return An iterator to the first element.
+ */
+template <typename T> typename rcu_dlist<T>::Iterator rcu_dlist<T>::begin()
+{
+    epoch_record &record = this_thread_epoch();
+    record.enter();
+
+    Iterator it(head.load(std::memory_order_acquire), &record);
+    record.exit();
+
+    return it;
+}
+
+/**
+ * @brief Returns the past-the-end iterator, which holds no read section.
+ *
+ * @return The past-the-end iterator.
+ */
+template <typename T> typename rcu_dlist<T>::Iterator rcu_dlist<T>::end()
+{
+    return Iterator(nullptr, nullptr);
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef CXC_RCU_DLIST_H
+#define CXC_RCU_DLIST_H
+
+#include "epoch.h"
+#include "node.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Doubly linked list with lock-free readers and a single writer.
+ *
+ * Readers walk the list forward through Iterator while one writer inserts and
+ * removes, neither waiting for the other. The writer builds a node completely
+ * before publishing it with a release store of one next link (or of head), so
+ * a reader sees either the old or the new chain. A removed node keeps its
+ * next link, so a reader standing on it carries on to the rest of the list.
+ * Removed nodes are tagged with the current epoch and freed once no reader
+ * can still reach them (see epoch_domain).
+ *
+ * An Iterator keeps its thread in a read section for as long as it lives, so
+ * `for (auto &v : list)` is safe on any thread without a lock. Iterators must
+ * stay on the thread that made them, and a reader may see elements inserted
+ * or removed during its walk, or not.
+ *
+ * Writer functions must be called by one thread at a time. Nodes are plain
+ * Node<T>, their next links are accessed through std::atomic_ref; prev links
+ * are only used by the writer.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> struct rcu_dlist
+{
+    // unlinked nodes kept before the writer tries to free them
+    static constexpr size_t reclaim_threshold = 64;
+
+  private:
+    struct Retired
+    {
+        Node<T> *node;
+        uint64_t epoch;
+    };
+
+    std::atomic<Node<T> *> head{nullptr};
+    std::atomic<size_t> m_size{0};
+    // the members below are only used by the writer
+    Node<T> *tail = nullptr;
+    std::vector<Retired> retired;
+
+    static std::atomic_ref<Node<T> *> link(Node<T> *&field);
+
+    void push_head(Node<T> *node);
+
+    void push_tail(Node<T> *node);
+
+    void unlink(Node<T> *node);
+
+  public:
+    struct Iterator
+    {
+      private:
+        Node<T> *m_ptr = nullptr;
+        epoch_record *m_record = nullptr;
+
+      public:
+        using pointer = const T *;
+        using value_type = T;
+        using reference = const T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator() = default;
+
+        Iterator(Node<T> *ptr, epoch_record *record) : m_ptr(ptr), m_record(record)
+        {
+            if (m_record != nullptr)
+                m_record->enter();
+        }
+
+        Iterator(const Iterator &other) : Iterator(other.m_ptr, other.m_record)
+        {
+        }
+
+        Iterator &operator=(const Iterator &other)
+        {
+            if (other.m_record != nullptr)
+                other.m_record->enter();
+
+            if (m_record != nullptr)
+                m_record->exit();
+
+            m_ptr = other.m_ptr;
+            m_record = other.m_record;
+
+            return *this;
+        }
+
+        ~Iterator()
+        {
+            if (m_record != nullptr)
+                m_record->exit();
+        }
+
+        reference operator*() const
+        {
+            return m_ptr->data;
+        }
+
+        pointer operator->() const
+        {
+            return &m_ptr->data;
+        }
+
+        Iterator &operator++()
+        {
+            m_ptr = link(m_ptr->next).load(std::memory_order_acquire);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++(*this);
+            return it;
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b)
+        {
+            return a.m_ptr == b.m_ptr;
+        }
+
+        friend bool operator!=(const Iterator &a, const Iterator &b)
+        {
+            return a.m_ptr != b.m_ptr;
+        }
+    };
+
+    rcu_dlist() = default;
+    rcu_dlist(const rcu_dlist &) = delete;
+    rcu_dlist &operator=(const rcu_dlist &) = delete;
+    ~rcu_dlist();
+
+    // inseration / deletion, writer only
+    void insert_head(T data);
+    void insert_tail(T data);
+
+    template <typename... Args> void emplace_head(Args &&...args);
+    template <typename... Args> void emplace_tail(Args &&...args);
+
+    void remove_head();
+    void remove_tail();
+    size_t remove(const T &value);
+    template <typename Pred> size_t remove_if(Pred pred);
+    void clear();
+
+    void reclaim();
+
+    // accessors
+    bool is_empty();
+    size_t size();
+
+    // iterators, for any thread
+    Iterator begin();
+    Iterator end();
+};
+
+} // namespace cxc
+
+#include "rcu_dlist.cpp"
+
+#endif
@@ -0,0 +1,806 @@
+#ifndef CXC_SIMD_H
+#define CXC_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * The kernels below are chosen when compiling: AVX2 when the compiler targets
+ * it (-mavx2, -march=native, /arch:AVX2), SSE2 on any other x86-64 target and
+ * plain loops elsewhere. Only float, double and 32 / 64-bit integers are
+ * vectorized; other types always take the scalar loops.
+ */
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CXC_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CXC_SIMD_SSE2
+#endif
+
+namespace cxc
+{
+
+/**
+ * @brief Predicate matching the elements smaller than a bound, vectorized by
+ * unrolled_dlist::find_if.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T> struct less_than
+{
+    T bound;
+
+    bool operator()(const T &value) const
+    {
+        return value < bound;
+    }
+};
+
+/**
+ * @brief Predicate matching the elements greater than a bound, vectorized by
+ * unrolled_dlist::find_if.
+ *
+ * @tparam T The type of the elements.
+ */
+template <typename T> struct greater_than
+{
+    T bound;
+
+    bool operator()(const T &value) const
+    {
+        return bound < value;
+    }
+};
+
+namespace simd
+{
+
+#if defined(CXC_SIMD_AVX2)
+inline constexpr const char *isa = "avx2";
+#elif defined(CXC_SIMD_SSE2)
+inline constexpr const char *isa = "sse2";
+#else
+inline constexpr const char *isa = "scalar";
+#endif
+
+/**
+ * @brief Number of set bits in a lane mask.
+ */
+inline unsigned popcount(unsigned mask)
+{
+#if defined(__POPCNT__)
+    return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+    // masks have at most 8 bits; without POPCNT the builtin is a library call
+    mask = mask - ((mask >> 1) & 0x55);
+    mask = (mask & 0x33) + ((mask >> 2) & 0x33);
+    return (mask + (mask >> 4)) & 0x0F;
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit of a non-zero lane mask.
+ */
+inline unsigned lowest(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned bit = 0;
+
+    for (; (mask & 1) == 0; mask >>= 1)
+        bit++;
+
+    return bit;
+#endif
+}
+
+/**
+ * @brief Lane type a kernel uses for T: T itself for float and double, the
+ * fixed-width integer of the same size and signedness for 32 and 64-bit
+ * integers, void for anything else.
+ */
+template <typename T, typename = void> struct lane
+{
+    using type = void;
+};
+
+template <> struct lane<float>
+{
+    using type = float;
+};
+
+template <> struct lane<double>
+{
+    using type = double;
+};
+
+template <typename T>
+inline constexpr bool integral_lane =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+template <typename T> struct lane<T, std::enable_if_t<integral_lane<T>>>
+{
+    using type = std::conditional_t<sizeof(T) == 4, std::conditional_t<std::is_signed_v<T>, int32_t, uint32_t>,
+                                    std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+};
+
+template <typename T> using lane_t = typename lane<T>::type;
+
+/**
+ * @brief Vector operations on lanes of type L.
+ *
+ * Each specialization provides a register type, its width in lanes, unaligned
+ * load / store, splat and add. Comparisons return one bit per lane. Those
+ * with ordered = true also provide lt, gt, min and max.
+ *
+ * @tparam L The lane type, void for types without kernels.
+ */
+template <typename L> struct ops
+{
+    static constexpr bool enabled = false;
+    static constexpr bool ordered = false;
+};
+
+#if defined(CXC_SIMD_AVX2)
+
+template <> struct ops<float>
+{
+    using reg = __m256;
+    static constexpr bool enabled = true;
+    static constexpr bool ordered = true;
+    static constexpr size_t width = 8;
+
+    static reg load(const float *p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+
+    static void store(float *p, reg r)
+    {
+        _mm256_storeu_ps(p, r);
+    }
+
+    static reg splat(float v)
+    {
+        return _mm256_set1_ps(v);
+    }
+
+    static reg add(reg a, reg b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+
+    static reg min(reg a, reg b)
+    {
+        return _mm256_min_ps(a, b);
+    }
+
+    static reg max(reg a, reg b)
+    {
+        return _mm256_max_ps(a, b);
+    }
+
+    static unsigned eq(reg a, reg b)
+    {
+        return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+    }
+
+    static unsigned lt(reg a, reg b)
+    {
+        return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+    }
+
+    static unsigned gt(reg a, reg b)
+    {
+        return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)));
+    }
+};
+
+template <> struct ops<double>
+{
+    using reg = __m256d;
+    static constexpr bool enabled = true;
+    static constexpr bool ordered = true;
+    static constexpr size_t width = 4;
+
+    static reg load(const double *p)
+    {
+        return _mm256_loadu_pd(p);
+    }
+
+    static void store(double *p, reg r)
+    {
+        _mm256_storeu_pd(p, r);
+    }
+
+    static reg splat(double v)
+    {
+        return _mm256_set1_pd(v);
+    }
+
+    static reg add(reg a, reg b)
+    {
+        return _mm256_add_pd(a, b);
+    }
+
+    static reg min(reg a, reg b)
+    {
+        return _mm256_min_pd(a, b);
+    }
+
+    static reg max(reg a, reg b)
+    {
+        return _mm256_max_pd(a, b);
+    }
+
+    static unsigned eq(reg a, reg b)
+    {
+        return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+    }
+
+    static unsigned lt(reg a, reg b)
+    {
+        return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+    }
+
+    static unsigned gt(reg a, reg b)
+    {
+        return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)));
+    }
+};
+
+/**
+ * @brief Integer lanes of 32 or 64 bits. Unsigned lanes are ordered by
+ * flipping their sign bit before a signed comparison.
+ */
+template <typename L> struct int_ops
+{
+    using reg = __m256i;
+    static constexpr bool enabled = true;
+    static constexpr bool ordered = true;
+    static constexpr size_t width = 32 / sizeof(L);
+
+    static reg load(const void *p)
+    {
+        return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+    }
+
+    static void store(L *p, reg r)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), r);
+    }
+
+    static reg splat(L v)
+    {
+        if constexpr (sizeof(L) == 4)
+            return _mm256_set1_epi32(static_cast<int32_t>(v));
+        else
+            return _mm256_set1_epi64x(static_cast<long long>(v));
+    }
+
+    static reg add(reg a, reg b)
+    {
+        if constexpr (sizeof(L) == 4)
+            return _mm256_add_epi32(a, b);
+        else
+            return _mm256_add_epi64(a, b);
+    }
+
+    static unsigned mask(reg r)
+    {
+        if constexpr (sizeof(L) == 4)
+            return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(r)));
+        else
+            return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(r)));
+    }
+
+    static reg cmpeq(reg a, reg b)
+    {
+        if constexpr (sizeof(L) == 4)
+            return _mm256_cmpeq_epi32(a, b);
+        else
+            return _mm256_cmpeq_epi64(a, b);
+    }
+
+    static reg cmpgt(reg a, reg b)
+    {
+        if constexpr (std::is_unsigned_v<L>)
+        {
+            reg bias = splat(L(1) << (sizeof(L) * 8 - 1));
+            a = _mm256_xor_si256(a, bias);
+            b = _mm256_xor_si256(b, bias);
+        }
+
+        if constexpr (sizeof(L) == 4)
+            return _mm256_cmpgt_epi32(a, b);
+        else
+            return _mm256_cmpgt_epi64(a, b);
+    }
+
+    static reg min(reg a, reg b)
+    {
+        return _mm256_blendv_epi8(a, b, cmpgt(a, b));
+    }
+
+    static reg max(reg a, reg b)
+    {
+        return _mm256_blendv_epi8(b, a, cmpgt(a, b));
+    }
+
+    static unsigned eq(reg a, reg b)
+    {
+        return mask(cmpeq(a, b));
+    }
+
+    static unsigned lt(reg a, reg b)
+    {
+        return mask(cmpgt(b, a));
+    }
+
+    static unsigned gt(reg a, reg b)
+    {
+        return mask(cmpgt(a, b));
+    }
+};
+
+#elif defined(CXC_SIMD_SSE2)
+
+template <> struct ops<float>
+{
+    using reg = __m128;
+    static constexpr bool enabled = true;
+    static constexpr bool ordered = true;
+    static constexpr size_t width = 4;
+
+    static reg load(const float *p)
+    {
+        return _mm_loadu_ps(p);
+    }
+
+    static void store(float *p, reg r)
+    {
+        _mm_storeu_ps(p, r);
+    }
+
+    static reg splat(float v)
+    {
+        return _mm_set1_ps(v);
+    }
+
+    static reg add(reg a, reg b)
+    {
+        return _mm_add_ps(a, b);
+    }
+
+    static reg min(reg a, reg b)
+    {
+        return _mm_min_ps(a, b);
+    }
+
+    static reg max(reg a, reg b)
+    {
+        return _mm_max_ps(a, b);
+    }
+
+    static unsigned eq(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(a, b)));
+    }
+
+    static unsigned lt(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_ps(_mm_cmplt_ps(a, b)));
+    }
+
+    static unsigned gt(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_ps(_mm_cmpgt_ps(a, b)));
+    }
+};
+
+template <> struct ops<double>
+{
+    using reg = __m128d;
+    static constexpr bool enabled = true;
+    static constexpr bool ordered = true;
+    static constexpr size_t width = 2;
+
+    static reg load(const double *p)
+    {
+        return _mm_loadu_pd(p);
+    }
+
+    static void store(double *p, reg r)
+    {
+        _mm_storeu_pd(p, r);
+    }
+
+    static reg splat(double v)
+    {
+        return _mm_set1_pd(v);
+    }
+
+    static reg add(reg a, reg b)
+    {
+        return _mm_add_pd(a, b);
+    }
+
+    static reg min(reg a, reg b)
+    {
+        return _mm_min_pd(a, b);
+    }
+
+    static reg max(reg a, reg b)
+    {
+        return _mm_max_pd(a, b);
+    }
+
+    static unsigned eq(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_pd(_mm_cmpeq_pd(a, b)));
+    }
+
+    static unsigned lt(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_pd(_mm_cmplt_pd(a, b)));
+    }
+
+    static unsigned gt(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_pd(_mm_cmpgt_pd(a, b)));
+    }
+};
+
+/**
+ * @brief Integer lanes of 32 or 64 bits. SSE2 has no 64-bit comparison, so
+ * only 32-bit lanes are ordered; unsigned ones by flipping their sign bit
+ * before a signed comparison.
+ */
+template <typename L> struct int_ops
+{
+    using reg = __m128i;
+    static constexpr bool enabled = true;
+    static constexpr bool ordered = sizeof(L) == 4;
+    static constexpr size_t width = 16 / sizeof(L);
+
+    static reg load(const void *p)
+    {
+        return _mm_loadu_si128(static_cast<const __m128i *>(p));
+    }
+
+    static void store(L *p, reg r)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), r);
+    }
+
+    static reg splat(L v)
+    {
+        if constexpr (sizeof(L) == 4)
+            return _mm_set1_epi32(static_cast<int32_t>(v));
+        else
+            return _mm_set1_epi64x(static_cast<long long>(v));
+    }
+
+    static reg add(reg a, reg b)
+    {
+        if constexpr (sizeof(L) == 4)
+            return _mm_add_epi32(a, b);
+        else
+            return _mm_add_epi64(a, b);
+    }
+
+    static unsigned eq(reg a, reg b)
+    {
+        reg equal = _mm_cmpeq_epi32(a, b);
+
+        if constexpr (sizeof(L) == 4)
+        {
+            return unsigned(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+        }
+        else
+        {
+            // a 64-bit lane is equal when both of its halves are
+            equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+            return unsigned(_mm_movemask_pd(_mm_castsi128_pd(equal)));
+        }
+    }
+
+    static reg cmpgt(reg a, reg b)
+    {
+        static_assert(sizeof(L) == 4, "SSE2 has no 64-bit comparison");
+
+        if constexpr (std::is_unsigned_v<L>)
+        {
+            reg bias = splat(L(1) << 31);
+            a = _mm_xor_si128(a, bias);
+            b = _mm_xor_si128(b, bias);
+        }
+
+        return _mm_cmpgt_epi32(a, b);
+    }
+
+    static reg select(reg mask, reg yes, reg no)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, yes), _mm_andnot_si128(mask, no));
+    }
+
+    static reg min(reg a, reg b)
+    {
+        return select(cmpgt(a, b), b, a);
+    }
+
+    static reg max(reg a, reg b)
+    {
+        return select(cmpgt(a, b), a, b);
+    }
+
+    static unsigned lt(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_ps(_mm_castsi128_ps(cmpgt(b, a))));
+    }
+
+    static unsigned gt(reg a, reg b)
+    {
+        return unsigned(_mm_movemask_ps(_mm_castsi128_ps(cmpgt(a, b))));
+    }
+};
+
+#endif
+
+#if defined(CXC_SIMD_AVX2) || defined(CXC_SIMD_SSE2)
+
+template <> struct ops<int32_t> : int_ops<int32_t>
+{
+};
+
+template <> struct ops<uint32_t> : int_ops<uint32_t>
+{
+};
+
+template <> struct ops<int64_t> : int_ops<int64_t>
+{
+};
+
+template <> struct ops<uint64_t> : int_ops<uint64_t>
+{
+};
+
+#endif
+
+template <typename T> using ops_for = ops<lane_t<T>>;
+
+/**
+ * @brief Type a sum of lanes is reduced in: unsigned for integer lanes, so
+ * that overflow wraps around instead of being undefined.
+ */
+template <typename L, bool = std::is_integral_v<L>> struct wrapping
+{
+    using type = L;
+};
+
+template <typename L> struct wrapping<L, true>
+{
+    using type = std::make_unsigned_t<L>;
+};
+
+/**
+ * @brief Whether the kernels vectorize find and count, sum, and, when
+ * ordered, find_if with less_than / greater_than, min and max over T.
+ */
+template <typename T> inline constexpr bool vectorized = ops_for<T>::enabled;
+
+template <typename T> inline constexpr bool ordered = ops_for<T>::ordered;
+
+/**
+ * @brief Reinterprets elements as lanes for the load; integers of the same
+ * size and signedness (long and long long) share one layout.
+ */
+template <typename T> const lane_t<T> *lanes(const T *data)
+{
+    return reinterpret_cast<const lane_t<T> *>(data);
+}
+
+/**
+ * @brief Index of the first element equal to a value.
+ *
+ * @return The index, or n if no element matches.
+ */
+template <typename T> size_t find(const T *data, size_t n, const T &value)
+{
+    size_t i = 0;
+
+    if constexpr (vectorized<T>)
+    {
+        using O = ops_for<T>;
+        auto needle = O::splat(static_cast<lane_t<T>>(value));
+
+        for (; i + O::width <= n; i += O::width)
+        {
+            unsigned hits = O::eq(O::load(lanes(data + i)), needle);
+
+            if (hits != 0)
+                return i + lowest(hits);
+        }
+    }
+
+    for (; i < n; i++)
+    {
+        if (data[i] == value)
+            return i;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Index of the first element matching a predicate, vectorized for
+ * less_than and greater_than.
+ *
+ * @return The index, or n if no element matches.
+ */
+template <typename T, typename Pred> size_t find_if(const T *data, size_t n, Pred &pred)
+{
+    size_t i = 0;
+
+    constexpr bool below = std::is_same_v<Pred, less_than<T>>;
+    constexpr bool above = std::is_same_v<Pred, greater_than<T>>;
+
+    if constexpr (ordered<T> && (below || above))
+    {
+        using O = ops_for<T>;
+        auto bound = O::splat(static_cast<lane_t<T>>(pred.bound));
+
+        for (; i + O::width <= n; i += O::width)
+        {
+            auto values = O::load(lanes(data + i));
+            unsigned hits = below ? O::lt(values, bound) : O::gt(values, bound);
+
+            if (hits != 0)
+                return i + lowest(hits);
+        }
+    }
+
+    for (; i < n; i++)
+    {
+        if (pred(data[i]))
+            return i;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Number of elements equal to a value.
+ */
+template <typename T> size_t count(const T *data, size_t n, const T &value)
+{
+    size_t i = 0;
+    size_t total = 0;
+
+    if constexpr (vectorized<T>)
+    {
+        using O = ops_for<T>;
+        auto needle = O::splat(static_cast<lane_t<T>>(value));
+
+        for (; i + O::width <= n; i += O::width)
+            total += popcount(O::eq(O::load(lanes(data + i)), needle));
+    }
+
+    for (; i < n; i++)
+    {
+        if (data[i] == value)
+            total++;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Sum of the elements.
+ *
+ * Vectorized sums add the elements in another order than a loop: float and
+ * double results can differ in the last bits, integer sums wrap around.
+ */
+template <typename T> T sum(const T *data, size_t n)
+{
+    size_t i = 0;
+
+    if constexpr (vectorized<T>)
+    {
+        using O = ops_for<T>;
+        using L = lane_t<T>;
+        using W = typename wrapping<L>::type;
+
+        // four accumulators keep the adds independent of one another
+        auto a0 = O::splat(L(0)), a1 = a0, a2 = a0, a3 = a0;
+
+        for (; i + 4 * O::width <= n; i += 4 * O::width)
+        {
+            a0 = O::add(a0, O::load(lanes(data + i)));
+            a1 = O::add(a1, O::load(lanes(data + i + O::width)));
+            a2 = O::add(a2, O::load(lanes(data + i + 2 * O::width)));
+            a3 = O::add(a3, O::load(lanes(data + i + 3 * O::width)));
+        }
+
+        for (; i + O::width <= n; i += O::width)
+            a0 = O::add(a0, O::load(lanes(data + i)));
+
+        L part[O::width];
+        O::store(part, O::add(O::add(a0, a1), O::add(a2, a3)));
+
+        W total = 0;
+
+        for (size_t lane = 0; lane < O::width; lane++)
+            total += static_cast<W>(part[lane]);
+
+        for (; i < n; i++)
+            total += static_cast<W>(data[i]);
+
+        return static_cast<T>(total);
+    }
+    else
+    {
+        T total{};
+
+        for (; i < n; i++)
+            total += data[i];
+
+        return total;
+    }
+}
+
+/**
+ * @brief Smallest element (or largest when Largest is true) of a non-empty
+ * range. With NaN elements the result is unspecified.
+ */
+template <bool Largest, typename T> T extreme(const T *data, size_t n)
+{
+    T best = data[0];
+    size_t i = 1;
+
+    if constexpr (ordered<T>)
+    {
+        using O = ops_for<T>;
+        using L = lane_t<T>;
+
+        if (n >= O::width)
+        {
+            auto acc = O::load(lanes(data));
+
+            for (i = O::width; i + O::width <= n; i += O::width)
+            {
+                auto values = O::load(lanes(data + i));
+                acc = Largest ? O::max(values, acc) : O::min(values, acc);
+            }
+
+            L part[O::width];
+            O::store(part, acc);
+            best = static_cast<T>(part[0]);
+
+            for (size_t lane = 1; lane < O::width; lane++)
+            {
+                T value = static_cast<T>(part[lane]);
+
+                if (Largest ? best < value : value < best)
+                    best = value;
+            }
+        }
+    }
+
+    for (; i < n; i++)
+    {
+        if (Largest ? best < data[i] : data[i] < best)
+            best = data[i];
+    }
+
+    return best;
+}
+
+} // namespace simd
+
+} // namespace cxc
+
+#endif
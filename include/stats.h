@@ -0,0 +1,61 @@
+#ifndef CXC_STATS_H
+#define CXC_STATS_H
+
+#include <cstddef>
+
+/**
+ * Defining CXC_DLIST_STATS before including dlist.h (or with
+ * -DCXC_DLIST_STATS) makes dlist count its allocations, positional lookups
+ * and iterator steps. Without it the counters are compiled out and read as 0.
+ */
+#ifdef CXC_DLIST_STATS
+#define CXC_DLIST_STAT(...) __VA_ARGS__
+#else
+#define CXC_DLIST_STAT(...)
+#endif
+
+namespace cxc
+{
+
+/**
+ * @brief Counters a dlist keeps when CXC_DLIST_STATS is defined.
+ */
+struct dlist_counters
+{
+    size_t allocations = 0;
+    size_t frees = 0;
+    size_t positional_ops = 0;
+    size_t iterator_steps = 0;
+};
+
+/**
+ * @brief Snapshot of a dlist's statistics, as returned by dlist::stats().
+ *
+ * The counters are cumulative since construction or the last reset_stats().
+ * heap_bytes is the memory held for the nodes: the whole arena for a
+ * node_pool, which copies sharing it report alike, or one node per element
+ * for heap_allocator. The skip_index towers are not included.
+ */
+struct dlist_stats
+{
+    // whether the counters below were compiled in
+    bool enabled = false;
+
+    size_t allocations = 0;
+    size_t frees = 0;
+    // get_node, change, insert_at / emplace_at and remove_at calls
+    size_t positional_ops = 0;
+    // nodes (and skip_index links) walked by those calls
+    size_t nodes_traversed = 0;
+    // increments and decrements of iterators obtained from the list
+    size_t iterator_steps = 0;
+
+    size_t size = 0;
+    size_t heap_bytes = 0;
+    // heap bytes per element beyond sizeof(T)
+    double overhead_per_element = 0;
+};
+
+} // namespace cxc
+
+#endif
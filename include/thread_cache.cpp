@@ -0,0 +1,296 @@
+#ifndef CXC_THREAD_CACHE_TPP
+#define CXC_THREAD_CACHE_TPP
+
+#include "thread_cache.h"
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Returns the head of the process-wide list of caches.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Reference to the head of the list.
+ */
+template <typename T> std::atomic<typename thread_cache_pool<T>::Cache *> &thread_cache_pool<T>::caches()
+{
+    static std::atomic<Cache *> head{nullptr};
+    return head;
+}
+
+/**
+ * @brief Takes over a cache released by an exiting thread, or adds a new one
+ * to the list.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Pointer to the cache, owned by the calling thread.
+ */
+template <typename T> typename thread_cache_pool<T>::Cache *thread_cache_pool<T>::acquire()
+{
+    for (Cache *cache = caches().load(std::memory_order_acquire); cache != nullptr; cache = cache->next)
+    {
+        bool active = false;
+
+        if (!cache->active.load(std::memory_order_relaxed) &&
+            cache->active.compare_exchange_strong(active, true, std::memory_order_acquire))
+            return cache;
+    }
+
+    Cache *cache = new Cache;
+    Cache *head = caches().load(std::memory_order_relaxed);
+
+    do
+    {
+        cache->next = head;
+    } while (!caches().compare_exchange_weak(head, cache, std::memory_order_release, std::memory_order_relaxed));
+
+    return cache;
+}
+
+/**
+ * @brief Returns the batch a thread holds for another cache and hands its
+ * own cache over to the next thread.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param cache The cache of the exiting thread.
+ */
+template <typename T> void thread_cache_pool<T>::release(Cache *cache)
+{
+    flush(*cache);
+    cache->active.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the cache of the calling thread, acquiring it on first use
+ * and releasing it when the thread exits.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Reference to the thread's cache.
+ */
+template <typename T> typename thread_cache_pool<T>::Cache &thread_cache_pool<T>::local()
+{
+    struct owner
+    {
+        Cache *cache = acquire();
+
+        ~owner()
+        {
+            release(cache);
+        }
+    };
+
+    thread_local owner current;
+    return *current.cache;
+}
+
+/**
+ * @brief Gives a cache a new slab to carve nodes from.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param cache The cache.
+ */
+template <typename T> void thread_cache_pool<T>::grow(Cache &cache)
+{
+    constexpr size_t bytes = slab_bytes();
+
+    void *memory = ::operator new(bytes, std::align_val_t(bytes));
+    cache.slabs = new (memory) Slab{&cache, cache.slabs};
+
+    cache.cursor = reinterpret_cast<Slot *>(static_cast<unsigned char *>(memory) + header_size);
+    cache.cursor_end = cache.cursor + (bytes - header_size) / sizeof(Slot);
+}
+
+/**
+ * @brief Takes the next never used slot of a cache, growing it if needed.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param cache The cache.
+ * @return Pointer to the slot.
+ */
+template <typename T> typename thread_cache_pool<T>::Slot *thread_cache_pool<T>::carve(Cache &cache)
+{
+    if (cache.cursor == cache.cursor_end)
+        grow(cache);
+
+    return cache.cursor++;
+}
+
+/**
+ * @brief Pushes the batch of remotely destroyed nodes a cache holds onto the
+ * returned nodes of their owner.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param cache The cache holding the batch.
+ */
+template <typename T> void thread_cache_pool<T>::flush(Cache &cache)
+{
+    if (cache.outgoing == nullptr)
+        return;
+
+    std::atomic<Slot *> &remote = cache.outgoing_owner->remote;
+    Slot *head = remote.load(std::memory_order_relaxed);
+
+    do
+    {
+        cache.outgoing_tail->next = head;
+    } while (!remote.compare_exchange_weak(head, cache.outgoing, std::memory_order_release, std::memory_order_relaxed));
+
+    cache.outgoing_owner = nullptr;
+    cache.outgoing = nullptr;
+    cache.outgoing_tail = nullptr;
+    cache.outgoing_count = 0;
+}
+
+/**
+ * @brief Returns the cache a node was allocated from, read at the start of
+ * its slab.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param node The node.
+ * @return Pointer to the owning cache.
+ */
+template <typename T> typename thread_cache_pool<T>::Cache *thread_cache_pool<T>::owner_of(const Node<T> *node)
+{
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(node);
+    return reinterpret_cast<const Slab *>(address & ~std::uintptr_t(slab_bytes() - 1))->owner;
+}
+
+/**
+ * @brief Constructs an unlinked node in a slot of the calling thread's
+ * cache: a freed one if any, else a new one.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T> template <typename... Args> Node<T> *thread_cache_pool<T>::create(Args &&...args)
+{
+    Cache &cache = local();
+
+    if (cache.free_list == nullptr && cache.remote.load(std::memory_order_relaxed) != nullptr)
+        cache.free_list = cache.remote.exchange(nullptr, std::memory_order_acquire);
+
+    Slot *slot = cache.free_list;
+
+    if (slot != nullptr)
+        cache.free_list = slot->next;
+    else
+        slot = carve(cache);
+
+    try
+    {
+        return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->next = cache.free_list;
+        cache.free_list = slot;
+        throw;
+    }
+}
+
+/**
+ * @brief Constructs an unlinked node in the next never used slot of the
+ * calling thread's cache, skipping the free list, so that nodes created in a
+ * row are adjacent in memory.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param args The arguments the data is constructed from.
+ * @return Pointer to the new node.
+ */
+template <typename T>
+template <typename... Args>
+Node<T> *thread_cache_pool<T>::create_contiguous(Args &&...args)
+{
+    Cache &cache = local();
+    Slot *slot = carve(cache);
+
+    try
+    {
+        return new (slot->storage) Node<T>(std::in_place, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        slot->next = cache.free_list;
+        cache.free_list = slot;
+        throw;
+    }
+}
+
+/**
+ * @brief Destroys a node, returning its slot to the calling thread's free
+ * list if the thread owns it, or to the batch for its owner otherwise.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param node The node to destroy.
+ */
+template <typename T> void thread_cache_pool<T>::destroy(Node<T> *node)
+{
+    Cache &cache = local();
+    Cache *owner = owner_of(node);
+
+    node->~Node<T>();
+    Slot *slot = reinterpret_cast<Slot *>(node);
+
+    if (owner == &cache)
+    {
+        slot->next = cache.free_list;
+        cache.free_list = slot;
+        return;
+    }
+
+    if (cache.outgoing_owner != owner)
+    {
+        flush(cache);
+        cache.outgoing_owner = owner;
+        cache.outgoing_tail = slot;
+    }
+
+    slot->next = cache.outgoing;
+    cache.outgoing = slot;
+
+    if (++cache.outgoing_count == batch_size)
+        flush(cache);
+}
+
+/**
+ * @brief The caches are shared by every list, so nodes are freed one by one.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Always false, the caller has to destroy every node itself.
+ */
+template <typename T> bool thread_cache_pool<T>::release()
+{
+    return false;
+}
+
+/**
+ * @brief The caches are shared by every list using the policy.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @return Always false.
+ */
+template <typename T> bool thread_cache_pool<T>::unique() const
+{
+    return false;
+}
+
+/**
+ * @brief Returns the bytes held for the given number of live nodes.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ * @param nodes The number of nodes created and not destroyed yet.
+ * @return One slot size per live node, the free slots of the caches excluded.
+ */
+template <typename T> size_t thread_cache_pool<T>::footprint(size_t nodes) const
+{
+    return nodes * sizeof(Slot);
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef CXC_THREAD_CACHE_H
+#define CXC_THREAD_CACHE_H
+
+#include "node.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace cxc
+{
+
+/**
+ * @brief Allocator policy giving every thread its own cache of nodes, for
+ * lists handed over between threads.
+ *
+ * Each thread allocates from a cache of its own, a free list and a slab
+ * being carved, so creating and destroying nodes takes no lock. Slabs are
+ * aligned on their size and start with the address of the cache that owns
+ * them, which tells in O(1) where a node goes back: a node destroyed by its
+ * owning thread returns to its free list, a node destroyed by another thread
+ * is put in a batch for the owning cache, and the whole batch is pushed with
+ * one compare-and-swap once it is full or the next remote node belongs to
+ * another cache. The owner takes every returned node at once when its free
+ * list runs out.
+ *
+ * Caches are never freed while the program runs: a thread releases its cache
+ * when it exits, the batch it holds being returned first, and the next thread
+ * asking for a cache takes it over with its free nodes. Lists must therefore
+ * not live in thread_local storage. All thread_cache_pool objects are
+ * equal, so lists exchange nodes in O(1) whichever threads created them; the
+ * lists themselves are not thread-safe and a handover needs a synchronization
+ * of its own.
+ *
+ * @tparam T The type of elements stored in the nodes.
+ */
+template <typename T> struct thread_cache_pool
+{
+    // remotely destroyed nodes returned to their owner together
+    static constexpr size_t batch_size = 64;
+    // smallest number of nodes in a slab
+    static constexpr size_t min_slab = 64;
+
+  private:
+    union Slot {
+        Slot *next;
+        alignas(Node<T>) unsigned char storage[sizeof(Node<T>)];
+    };
+
+    struct Cache;
+
+    struct Slab
+    {
+        Cache *owner;
+        Slab *next;
+    };
+
+    static constexpr size_t header_size = (sizeof(Slab) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+
+    static constexpr size_t slab_bytes()
+    {
+        size_t bytes = size_t(1) << 16;
+
+        while (bytes < header_size + min_slab * sizeof(Slot))
+            bytes <<= 1;
+
+        return bytes;
+    }
+
+    struct Cache
+    {
+        // nodes returned by other threads, taken all at once by the owner
+        std::atomic<Slot *> remote{nullptr};
+        std::atomic<bool> active{true};
+        Cache *next = nullptr;
+
+        Slab *slabs = nullptr;
+        Slot *free_list = nullptr;
+        Slot *cursor = nullptr;
+        Slot *cursor_end = nullptr;
+
+        // nodes of another cache destroyed by this thread, not returned yet
+        Cache *outgoing_owner = nullptr;
+        Slot *outgoing = nullptr;
+        Slot *outgoing_tail = nullptr;
+        size_t outgoing_count = 0;
+    };
+
+    static std::atomic<Cache *> &caches();
+
+    static Cache *acquire();
+
+    static void release(Cache *cache);
+
+    static Cache &local();
+
+    static void grow(Cache &cache);
+
+    static Slot *carve(Cache &cache);
+
+    static void flush(Cache &cache);
+
+    static Cache *owner_of(const Node<T> *node);
+
+  public:
+    template <typename... Args> Node<T> *create(Args &&...args);
+
+    template <typename... Args> Node<T> *create_contiguous(Args &&...args);
+
+    void destroy(Node<T> *node);
+
+    bool release();
+
+    bool unique() const;
+
+    size_t footprint(size_t nodes) const;
+
+    bool operator==(const thread_cache_pool &) const
+    {
+        return true;
+    }
+};
+
+} // namespace cxc
+
+#include "thread_cache.cpp"
+
+#endif
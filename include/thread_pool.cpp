@@ -0,0 +1,245 @@
+#ifndef CXC_THREAD_POOL_TPP
+#define CXC_THREAD_POOL_TPP
+
+#include "thread_pool.h"
+
+#include <exception>
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief The pool and queue index of the calling thread, if it is a worker.
+ */
+struct pool_worker
+{
+    const work_stealing_pool *pool = nullptr;
+    size_t queue = 0;
+};
+
+inline pool_worker &this_thread_worker()
+{
+    static thread_local pool_worker worker;
+    return worker;
+}
+
+/**
+ * @brief Starts the workers.
+ *
+ * @param workers The number of worker threads, 0 to run every task on the
+ * threads calling run().
+ */
+inline work_stealing_pool::work_stealing_pool(size_t workers)
+{
+    for (size_t i = 0; i <= workers; i++)
+        queues.push_back(std::make_unique<Queue>());
+
+    for (size_t i = 0; i < workers; i++)
+        threads.emplace_back([this, i]() { work(i); });
+}
+
+/**
+ * @brief Stops the workers once the queued tasks are done.
+ */
+inline work_stealing_pool::~work_stealing_pool()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+/**
+ * @brief Returns the process-wide pool, with one worker per hardware thread
+ * besides the caller.
+ *
+ * @return Reference to the pool.
+ */
+inline work_stealing_pool &work_stealing_pool::instance()
+{
+    static work_stealing_pool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1
+                                                                            : 0);
+    return pool;
+}
+
+/**
+ * @brief Returns the number of worker threads.
+ *
+ * @return The number of workers, not counting the threads calling run().
+ */
+inline size_t work_stealing_pool::size()
+{
+    return threads.size();
+}
+
+/**
+ * @brief Returns the queue of the calling thread: its own for a worker, the
+ * shared one otherwise.
+ *
+ * @return The index of the queue.
+ */
+inline size_t work_stealing_pool::home()
+{
+    pool_worker &worker = this_thread_worker();
+    return worker.pool == this ? worker.queue : threads.size();
+}
+
+/**
+ * @brief Queues a task on the calling thread's queue and wakes a worker.
+ *
+ * @param task The task.
+ */
+inline void work_stealing_pool::submit(std::function<void()> task)
+{
+    Queue &queue = *queues[home()];
+
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(sleep_lock);
+        pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    wake.notify_one();
+}
+
+/**
+ * @brief Runs one task: the newest of a queue, or else the oldest of
+ * another queue.
+ *
+ * @param own The queue to look at first.
+ * @return true if a task was run, false if every queue was empty.
+ */
+inline bool work_stealing_pool::run_one(size_t own)
+{
+    std::function<void()> task;
+
+    for (size_t i = 0; i < queues.size() && !task; i++)
+    {
+        Queue &queue = *queues[(own + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(queue.lock);
+
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task)
+        return false;
+
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    return true;
+}
+
+/**
+ * @brief Body of a worker thread: runs tasks, sleeping while there are none.
+ *
+ * @param queue The index of the worker's queue.
+ */
+inline void work_stealing_pool::work(size_t queue)
+{
+    this_thread_worker() = pool_worker{this, queue};
+
+    while (true)
+    {
+        if (run_one(queue))
+            continue;
+
+        std::unique_lock<std::mutex> guard(sleep_lock);
+        wake.wait(guard, [this]() { return stopping || pending.load(std::memory_order_relaxed) > 0; });
+
+        if (stopping && pending.load(std::memory_order_relaxed) == 0)
+            return;
+    }
+}
+
+/**
+ * @brief Calls fn(0) ... fn(count - 1) as tasks of the pool and waits for
+ * all of them, running queued tasks on the calling thread meanwhile.
+ *
+ * Once every queue is empty, the remaining calls of the batch are running on
+ * other threads, and the caller sleeps until the last of them is done.
+ *
+ * If calls throw, the others still run and the first exception is rethrown.
+ *
+ * @tparam Fn The type of the function.
+ * @param count The number of calls.
+ * @param fn The function, called concurrently with different indices.
+ */
+template <typename Fn> void work_stealing_pool::run(size_t count, Fn &fn)
+{
+    std::atomic<size_t> left{count};
+    std::exception_ptr error;
+    std::mutex error_lock;
+    std::mutex done_lock;
+    std::condition_variable done;
+    bool finished = count == 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        submit([&, i]() {
+            try
+            {
+                fn(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard(error_lock);
+
+                if (!error)
+                    error = std::current_exception();
+            }
+
+            // the last call notifies under the lock, and run() returns only
+            // once it sees finished under the same lock, so the condition
+            // variable outlives the notification
+            if (left.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> guard(done_lock);
+                finished = true;
+                done.notify_one();
+            }
+        });
+    }
+
+    size_t own = home();
+
+    // once no queue holds a task, the calls left are running on other threads
+    while (left.load(std::memory_order_acquire) != 0)
+    {
+        if (!run_one(own))
+            break;
+    }
+
+    {
+        std::unique_lock<std::mutex> guard(done_lock);
+        done.wait(guard, [&finished]() { return finished; });
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace cxc
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef CXC_THREAD_POOL_H
+#define CXC_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cxc
+{
+
+/**
+ * @brief Fixed set of worker threads, each with its own task queue.
+ *
+ * A worker runs the newest task of its own queue first and, when that queue
+ * is empty, steals the oldest task of another queue. Threads that are not
+ * workers submit to a shared queue. run() blocks until a batch of tasks is
+ * done, the calling thread running queued tasks meanwhile, so a task may
+ * itself call run() without deadlocking the pool.
+ */
+struct work_stealing_pool
+{
+  private:
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // one queue per worker, then the queue of the other threads
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> pending{0};
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    size_t home();
+
+    void submit(std::function<void()> task);
+
+    bool run_one(size_t queue);
+
+    void work(size_t queue);
+
+  public:
+    explicit work_stealing_pool(size_t workers);
+    work_stealing_pool(const work_stealing_pool &) = delete;
+    work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+    ~work_stealing_pool();
+
+    static work_stealing_pool &instance();
+
+    size_t size();
+
+    template <typename Fn> void run(size_t count, Fn &fn);
+};
+
+} // namespace cxc
+
+#include "thread_pool.cpp"
+
+#endif
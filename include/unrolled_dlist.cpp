@@ -0,0 +1,685 @@
+#ifndef CXC_UNROLLED_DLIST_TPP
+#define CXC_UNROLLED_DLIST_TPP
+
+#include "unrolled_dlist.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace cxc
+{
+
+/**
+ * @brief Constructor for the unrolled_dlist struct.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param args The arguments used to initialize the list.
+ */
+template <typename T, size_t K> template <typename... Args> unrolled_dlist<T, K>::unrolled_dlist(Args... args)
+{
+    init(args...);
+}
+
+/**
+ * @brief Destructor for the unrolled_dlist struct, destroys every chunk.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ */
+template <typename T, size_t K> unrolled_dlist<T, K>::~unrolled_dlist()
+{
+    clear();
+}
+
+/**
+ * @brief Helper function recursively appending the constructor arguments.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param first The first argument used to initialize the list.
+ * @param rest The remaining arguments used to initialize the list.
+ */
+template <typename T, size_t K> template <typename... Args> void unrolled_dlist<T, K>::init(T first, Args... rest)
+{
+    insert_tail(first);
+    init(rest...);
+}
+
+/**
+ * @brief Base case for the recursive initialization of the unrolled_dlist.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::init()
+{
+}
+
+/**
+ * @brief Allocates an empty chunk and links it between two chunks.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param prev The chunk before the new one, nullptr for a new head.
+ * @param next The chunk after the new one, nullptr for a new tail.
+ * @return Pointer to the new chunk.
+ */
+template <typename T, size_t K>
+Chunk<T, K> *unrolled_dlist<T, K>::create_chunk(Chunk<T, K> *prev, Chunk<T, K> *next)
+{
+    Chunk<T, K> *chunk = new Chunk<T, K>;
+    chunk->prev = prev;
+    chunk->next = next;
+
+    if (prev != nullptr)
+        prev->next = chunk;
+    else
+        head = chunk;
+
+    if (next != nullptr)
+        next->prev = chunk;
+    else
+        tail = chunk;
+
+    return chunk;
+}
+
+/**
+ * @brief Unlinks a chunk, destroys its elements and frees it.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param chunk The chunk to destroy.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::destroy_chunk(Chunk<T, K> *chunk)
+{
+    if (chunk->prev != nullptr)
+        chunk->prev->next = chunk->next;
+    else
+        head = chunk->next;
+
+    if (chunk->next != nullptr)
+        chunk->next->prev = chunk->prev;
+    else
+        tail = chunk->prev;
+
+    std::destroy_n(chunk->data(), chunk->count);
+    delete chunk;
+}
+
+/**
+ * @brief Moves the upper half of a full chunk into a new chunk linked after it.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param chunk The chunk to split.
+ * @return The new chunk holding the upper half.
+ */
+template <typename T, size_t K> Chunk<T, K> *unrolled_dlist<T, K>::split(Chunk<T, K> *chunk)
+{
+    Chunk<T, K> *upper = create_chunk(chunk, chunk->next);
+    size_t keep = chunk->count / 2;
+
+    std::uninitialized_move(chunk->data() + keep, chunk->data() + chunk->count, upper->data());
+    std::destroy(chunk->data() + keep, chunk->data() + chunk->count);
+
+    upper->count = chunk->count - keep;
+    chunk->count = keep;
+
+    return upper;
+}
+
+/**
+ * @brief Merges a chunk that fell under half capacity with a neighbour, if
+ * both fit in a single chunk.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param chunk The chunk to merge.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::merge(Chunk<T, K> *chunk)
+{
+    Chunk<T, K> *into = chunk;
+    Chunk<T, K> *from = chunk->next;
+
+    if (from == nullptr || into->count + from->count > K)
+    {
+        into = chunk->prev;
+        from = chunk;
+
+        if (into == nullptr || into->count + from->count > K)
+            return;
+    }
+
+    std::uninitialized_move(from->data(), from->data() + from->count, into->data() + into->count);
+    into->count += from->count;
+
+    destroy_chunk(from);
+}
+
+/**
+ * @brief Inserts an element at the given index of a chunk, splitting the chunk
+ * first if it is full.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param chunk The chunk to insert into.
+ * @param index The index inside the chunk, at most its element count.
+ * @param data The data to be stored.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::insert_into(Chunk<T, K> *chunk, size_t index, T data)
+{
+    if (chunk->count == K)
+    {
+        Chunk<T, K> *upper = split(chunk);
+
+        if (index > chunk->count)
+        {
+            index -= chunk->count;
+            chunk = upper;
+        }
+    }
+
+    T *elements = chunk->data();
+
+    new (elements + chunk->count) T(std::move(data));
+    std::rotate(elements + index, elements + chunk->count, elements + chunk->count + 1);
+    chunk->count++;
+
+    m_size++;
+}
+
+/**
+ * @brief Removes the element at the given index of a chunk, freeing or merging
+ * the chunk when it runs low.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param chunk The chunk to remove from.
+ * @param index The index inside the chunk.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::remove_from(Chunk<T, K> *chunk, size_t index)
+{
+    T *elements = chunk->data();
+
+    std::move(elements + index + 1, elements + chunk->count, elements + index);
+    std::destroy_at(elements + chunk->count - 1);
+    chunk->count--;
+
+    m_size--;
+
+    if (chunk->count == 0)
+        destroy_chunk(chunk);
+    else if (chunk->count < K / 2)
+        merge(chunk);
+}
+
+/**
+ * @brief Finds the chunk holding the element at a position, walking from the
+ * closer end of the list.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param position The position in the list, replaced by the index inside the
+ * returned chunk.
+ * @return The chunk holding the element.
+ */
+template <typename T, size_t K> Chunk<T, K> *unrolled_dlist<T, K>::locate(size_t &position)
+{
+    if (position < m_size / 2)
+    {
+        Chunk<T, K> *chunk = head;
+
+        while (position >= chunk->count)
+        {
+            position -= chunk->count;
+            chunk = chunk->next;
+        }
+
+        return chunk;
+    }
+
+    Chunk<T, K> *chunk = tail;
+    size_t from_back = m_size - 1 - position;
+
+    while (from_back >= chunk->count)
+    {
+        from_back -= chunk->count;
+        chunk = chunk->prev;
+    }
+
+    position = chunk->count - 1 - from_back;
+    return chunk;
+}
+
+/**
+ * @brief Checks if a given position is valid within the list.
+ *
+ * @param position The position to check.
+ * @return true if the position is valid, false otherwise.
+ */
+template <typename T, size_t K> bool unrolled_dlist<T, K>::valid_position(size_t position)
+{
+    return position <= m_size - 1;
+}
+
+/**
+ * @brief Function to print each element of the list.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::print()
+{
+    for (Chunk<T, K> *chunk = head; chunk != nullptr; chunk = chunk->next)
+    {
+        for (size_t i = 0; i < chunk->count; i++)
+            std::cout << chunk->data()[i] << std::endl;
+    }
+}
+
+/**
+ * @brief Checks if the list is empty.
+ *
+ * @return true if the list is empty, false otherwise.
+ */
+template <typename T, size_t K> bool unrolled_dlist<T, K>::is_empty()
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief Checks if the list contains only one element.
+ *
+ * @return true if the list contains only one element, false otherwise.
+ */
+template <typename T, size_t K> bool unrolled_dlist<T, K>::only_element()
+{
+    return m_size == 1;
+}
+
+/**
+ * @brief Inserts an element at the head of the list.
+ *
+ * When the head chunk is full a new chunk is started in front of it, so a run
+ * of head insertions fills chunks instead of splitting them.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::insert_head(T data)
+{
+    Chunk<T, K> *chunk = head;
+
+    if (chunk == nullptr || chunk->count == K)
+        chunk = create_chunk(nullptr, head);
+
+    insert_into(chunk, 0, std::move(data));
+}
+
+/**
+ * @brief Inserts an element at the tail of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::insert_tail(T data)
+{
+    Chunk<T, K> *chunk = tail;
+
+    if (chunk == nullptr || chunk->count == K)
+        chunk = create_chunk(tail, nullptr);
+
+    new (chunk->data() + chunk->count) T(std::move(data));
+    chunk->count++;
+
+    m_size++;
+}
+
+/**
+ * @brief Inserts an element at the tail of the list.
+ *
+ * @param data The data to be stored.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::insert(T data)
+{
+    insert_tail(std::move(data));
+}
+
+/**
+ * @brief Inserts an element at the specified position, with the same position
+ * rules as dlist::insert_at.
+ *
+ * @param position The position at which to insert the element.
+ * @param data The data to be stored.
+ * @throws std::runtime_error if the position is invalid or out of bounds.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::insert_at(size_t position, T data)
+{
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] insert_at: position is invalid or out of bounds.");
+
+    if (position == 0)
+    {
+        insert_head(std::move(data));
+    }
+    else if (position == m_size - 1)
+    {
+        insert_tail(std::move(data));
+    }
+    else
+    {
+        Chunk<T, K> *chunk = locate(position);
+        insert_into(chunk, position, std::move(data));
+    }
+}
+
+/**
+ * @brief Destroys every element and frees every chunk.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::clear()
+{
+    Chunk<T, K> *chunk = head;
+
+    while (chunk != nullptr)
+    {
+        Chunk<T, K> *next = chunk->next;
+
+        std::destroy_n(chunk->data(), chunk->count);
+        delete chunk;
+
+        chunk = next;
+    }
+
+    head = nullptr;
+    tail = nullptr;
+    m_size = 0;
+}
+
+/**
+ * @brief Removes the element at the head of the list.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::remove_head()
+{
+    if (is_empty())
+        return;
+
+    remove_from(head, 0);
+}
+
+/**
+ * @brief Removes the element at the tail of the list.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::remove_tail()
+{
+    if (is_empty())
+        return;
+
+    remove_from(tail, tail->count - 1);
+}
+
+/**
+ * @brief Removes the element at the specified position.
+ *
+ * @param position The position of the element to remove.
+ * @throws std::runtime_error if the position is invalid or out of bounds.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::remove_at(size_t position)
+{
+    if (!valid_position(position))
+        throw std::runtime_error("[Error] remove_at: position is invalid or out of bounds.");
+
+    if (is_empty())
+        return;
+
+    Chunk<T, K> *chunk = locate(position);
+    remove_from(chunk, position);
+}
+
+/**
+ * @brief Reverses the order of the elements, chunk by chunk.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::reverse()
+{
+    Chunk<T, K> *chunk = head;
+
+    while (chunk != nullptr)
+    {
+        std::reverse(chunk->data(), chunk->data() + chunk->count);
+        std::swap(chunk->prev, chunk->next);
+
+        chunk = chunk->prev;
+    }
+
+    std::swap(head, tail);
+}
+
+/**
+ * @brief Finds the first element equal to a value.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param value The value to look for.
+ * @return An iterator to the element, or end() if there is none.
+ */
+template <typename T, size_t K> typename unrolled_dlist<T, K>::Iterator unrolled_dlist<T, K>::find(const T &value)
+{
+    for (Chunk<T, K> *chunk = head; chunk != nullptr; chunk = chunk->next)
+    {
+        size_t index = simd::find(chunk->data(), chunk->count, value);
+
+        if (index != chunk->count)
+            return Iterator(chunk, index, &tail);
+    }
+
+    return end();
+}
+
+/**
+ * @brief Finds the first element matching a predicate. cxc::less_than and
+ * cxc::greater_than are vectorized, other predicates are called once per
+ * element.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @tparam Pred The type of the predicate.
+ * @param pred The predicate.
+ * @return An iterator to the element, or end() if there is none.
+ */
+template <typename T, size_t K>
+template <typename Pred>
+typename unrolled_dlist<T, K>::Iterator unrolled_dlist<T, K>::find_if(Pred pred)
+{
+    for (Chunk<T, K> *chunk = head; chunk != nullptr; chunk = chunk->next)
+    {
+        size_t index = simd::find_if(chunk->data(), chunk->count, pred);
+
+        if (index != chunk->count)
+            return Iterator(chunk, index, &tail);
+    }
+
+    return end();
+}
+
+/**
+ * @brief Counts the elements equal to a value.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @param value The value to count.
+ * @return The number of equal elements.
+ */
+template <typename T, size_t K> size_t unrolled_dlist<T, K>::count(const T &value)
+{
+    size_t total = 0;
+
+    for (Chunk<T, K> *chunk = head; chunk != nullptr; chunk = chunk->next)
+        total += simd::count(chunk->data(), chunk->count, value);
+
+    return total;
+}
+
+/**
+ * @brief Checks if the list holds an element equal to a value.
+ *
+ * @param value The value to look for.
+ * @return true if an element is equal to the value, false otherwise.
+ */
+template <typename T, size_t K> bool unrolled_dlist<T, K>::contains(const T &value)
+{
+    return find(value) != end();
+}
+
+/**
+ * @brief Adds up the elements, T{} for an empty list.
+ *
+ * The vectorized kernels add in another order than a loop would, so float and
+ * double sums can differ from std::accumulate in the last bits; integer sums
+ * wrap around on overflow.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @return The sum of the elements.
+ */
+template <typename T, size_t K> T unrolled_dlist<T, K>::sum()
+{
+    T total{};
+
+    for (Chunk<T, K> *chunk = head; chunk != nullptr; chunk = chunk->next)
+        total += simd::sum(chunk->data(), chunk->count);
+
+    return total;
+}
+
+/**
+ * @brief Returns the smallest element. Unspecified if the list holds a NaN.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @return A copy of the smallest element.
+ * @throws std::runtime_error if the list is empty.
+ */
+template <typename T, size_t K> T unrolled_dlist<T, K>::min()
+{
+    if (is_empty())
+        throw std::runtime_error("[Error] min: list is empty.");
+
+    T best = simd::extreme<false>(head->data(), head->count);
+
+    for (Chunk<T, K> *chunk = head->next; chunk != nullptr; chunk = chunk->next)
+    {
+        T candidate = simd::extreme<false>(chunk->data(), chunk->count);
+
+        if (candidate < best)
+            best = std::move(candidate);
+    }
+
+    return best;
+}
+
+/**
+ * @brief Returns the largest element. Unspecified if the list holds a NaN.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ * @return A copy of the largest element.
+ * @throws std::runtime_error if the list is empty.
+ */
+template <typename T, size_t K> T unrolled_dlist<T, K>::max()
+{
+    if (is_empty())
+        throw std::runtime_error("[Error] max: list is empty.");
+
+    T best = simd::extreme<true>(head->data(), head->count);
+
+    for (Chunk<T, K> *chunk = head->next; chunk != nullptr; chunk = chunk->next)
+    {
+        T candidate = simd::extreme<true>(chunk->data(), chunk->count);
+
+        if (best < candidate)
+            best = std::move(candidate);
+    }
+
+    return best;
+}
+
+/**
+ * @brief Returns a reference to the first element of the list.
+ *
+ * @return A const reference to the first element.
+ * @throws std::runtime_error if the list is empty.
+ */
+template <typename T, size_t K> const T &unrolled_dlist<T, K>::get_head()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access head data.");
+
+    return head->data()[0];
+}
+
+/**
+ * @brief Returns a reference to the last element of the list.
+ *
+ * @return A const reference to the last element.
+ * @throws std::runtime_error if the list is empty.
+ */
+template <typename T, size_t K> const T &unrolled_dlist<T, K>::get_tail()
+{
+    if (is_empty())
+        throw std::runtime_error("List is empty, cannot access tail data.");
+
+    return tail->data()[tail->count - 1];
+}
+
+/**
+ * @brief Returns the number of elements in the list.
+ *
+ * @return The size of the list.
+ */
+template <typename T, size_t K> const size_t &unrolled_dlist<T, K>::size()
+{
+    return m_size;
+}
+
+/**
+ * @brief Returns the element at the specified position.
+ *
+ * @param position The position of the element.
+ * @return Reference to the element.
+ * @throws std::runtime_error if the position is invalid or out of bounds.
+ */
+template <typename T, size_t K> T &unrolled_dlist<T, K>::get(size_t position)
+{
+    if (!valid_position(position) || is_empty())
+        throw std::runtime_error("[Error] get: position is invalid or out of bounds.");
+
+    Chunk<T, K> *chunk = locate(position);
+    return chunk->data()[position];
+}
+
+/**
+ * @brief Changes the element at the specified position.
+ *
+ * @param position The position of the element to change.
+ * @param data The new data for the element.
+ * @throws std::runtime_error if the position is invalid or out of bounds.
+ */
+template <typename T, size_t K> void unrolled_dlist<T, K>::change(size_t position, T data)
+{
+    if (!valid_position(position) || is_empty())
+        throw std::runtime_error("[Error] change: position is invalid or out of bounds");
+
+    Chunk<T, K> *chunk = locate(position);
+    chunk->data()[position] = std::move(data);
+}
+
+} // namespace cxc
+
+#endif
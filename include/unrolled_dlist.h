@@ -0,0 +1,251 @@
+#ifndef CXC_UNROLLED_DLIST_H
+#define CXC_UNROLLED_DLIST_H
+
+#include "simd.h"
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <new>
+
+namespace cxc
+{
+
+/**
+ * @brief Default number of elements per chunk, about half a kilobyte of
+ * payload.
+ *
+ * @tparam T The type of elements stored in the list.
+ */
+template <typename T> constexpr size_t unrolled_chunk = sizeof(T) >= 128 ? 4 : 512 / sizeof(T);
+
+/**
+ * @brief Node of an unrolled_dlist holding up to K contiguous elements.
+ *
+ * @tparam T The type of elements stored in the chunk.
+ * @tparam K The capacity of the chunk.
+ */
+template <typename T, size_t K> struct Chunk
+{
+    Chunk *prev = nullptr;
+    Chunk *next = nullptr;
+    size_t count = 0;
+    alignas(T) unsigned char storage[K * sizeof(T)];
+
+    T *data()
+    {
+        return std::launder(reinterpret_cast<T *>(storage));
+    }
+};
+
+/**
+ * @brief Unrolled doubly linked list.
+ *
+ * Elements are stored K at a time in contiguous chunks, so a scan touches one
+ * cache line per few elements instead of one heap node per element, while
+ * insertion in the middle only shifts the elements of a single chunk. Chunks
+ * are split when an insertion overflows them and merged with a neighbour when
+ * removals leave them less than half full.
+ *
+ * Any insertion or removal invalidates iterators.
+ *
+ * find, find_if, count, contains, sum, min and max run over each chunk's
+ * contiguous elements with the SSE2 / AVX2 kernels of simd.h when T is float,
+ * double or a 32 / 64-bit integer, and with plain loops otherwise.
+ *
+ * @tparam T The type of elements stored in the list.
+ * @tparam K The number of elements per chunk.
+ */
+template <typename T, size_t K = unrolled_chunk<T>> struct unrolled_dlist
+{
+    static_assert(K >= 2, "unrolled_dlist chunks need room for at least two elements");
+
+  private:
+    size_t m_size = 0;
+    Chunk<T, K> *head = nullptr;
+    Chunk<T, K> *tail = nullptr;
+
+    template <typename... Args> void init(T first, Args... rest);
+
+    void init();
+
+    bool valid_position(size_t position);
+
+    Chunk<T, K> *locate(size_t &position);
+
+    Chunk<T, K> *create_chunk(Chunk<T, K> *prev, Chunk<T, K> *next);
+
+    void destroy_chunk(Chunk<T, K> *chunk);
+
+    Chunk<T, K> *split(Chunk<T, K> *chunk);
+
+    void merge(Chunk<T, K> *chunk);
+
+    void insert_into(Chunk<T, K> *chunk, size_t index, T data);
+
+    void remove_from(Chunk<T, K> *chunk, size_t index);
+
+  public:
+    struct Iterator;
+
+    template <typename... Args> unrolled_dlist(Args... args);
+    unrolled_dlist(const unrolled_dlist &) = delete;
+    unrolled_dlist &operator=(const unrolled_dlist &) = delete;
+    ~unrolled_dlist();
+
+    //  inseration / deletion
+    void insert_head(T data);
+    void insert_tail(T data);
+
+    void insert(T data);
+    void insert_at(size_t position, T data);
+
+    void clear();
+    void remove_head();
+    void remove_tail();
+    void remove_at(size_t position);
+
+    // modify
+    void change(size_t position, T data);
+
+    // accessors
+    bool is_empty();
+    const T &get_head();
+    const T &get_tail();
+    const size_t &size();
+    T &get(size_t position);
+
+    // search / reductions, vectorized for arithmetic types (see simd.h)
+    Iterator find(const T &value);
+    template <typename Pred> Iterator find_if(Pred pred);
+    size_t count(const T &value);
+    bool contains(const T &value);
+    T sum();
+    T min();
+    T max();
+
+    // misc
+    void print();
+    void reverse();
+    bool only_element();
+
+    /**
+     * @brief Bidirectional iterator over the elements of an unrolled_dlist.
+     * end() can be decremented to reach the last element.
+     *
+     * @tparam T The type of elements stored in the list.
+     */
+    struct Iterator
+    {
+        using pointer = T *;
+        using value_type = T;
+        using reference = T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+      private:
+        Chunk<T, K> *chunk;
+        size_t index;
+        // the owning list's tail chunk, for decrementing end()
+        Chunk<T, K> *const *last = nullptr;
+
+      public:
+        Iterator(Chunk<T, K> *_chunk = nullptr, size_t _index = 0) : chunk(_chunk), index(_index)
+        {
+        }
+
+        Iterator(Chunk<T, K> *_chunk, size_t _index, Chunk<T, K> *const *_last)
+            : chunk(_chunk), index(_index), last(_last)
+        {
+        }
+
+        T &operator*() const
+        {
+            return chunk->data()[index];
+        }
+
+        Iterator &operator++()
+        {
+            if (++index == chunk->count)
+            {
+                chunk = chunk->next;
+                index = 0;
+            }
+
+            return *this;
+        }
+
+        Iterator &operator--()
+        {
+            if (index == 0)
+            {
+                chunk = chunk != nullptr ? chunk->prev : *last;
+                index = chunk->count;
+            }
+
+            index--;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return chunk == other.chunk && index == other.index;
+        }
+
+        bool operator!=(const Iterator &other) const
+        {
+            return !(*this == other);
+        }
+
+        Chunk<T, K> *get_chunk()
+        {
+            return chunk;
+        }
+
+        size_t get_index()
+        {
+            return index;
+        }
+    };
+
+    /**
+     * @brief Returns an iterator pointing to the first element in the list.
+     *
+     * @return An iterator pointing to the first element in the list.
+     */
+    Iterator begin()
+    {
+        return Iterator(head, 0, &tail);
+    }
+
+    /**
+     * @brief Returns an iterator referring to the past-the-end element in the
+     * list.
+     *
+     * @return An iterator referring to the past-the-end element in the list.
+     */
+    Iterator end()
+    {
+        return Iterator(nullptr, 0, &tail);
+    }
+};
+
+} // namespace cxc
+
+#include "unrolled_dlist.cpp"
+
+#endif
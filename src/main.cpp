@@ -27,9 +27,11 @@ int main()
     list.insert(1001);
     list.insert_head(999);
     list.insert(1002);
-    list.reverse();
-    list.print();
-    list.reverse();
+    for (float value : list.reversed())
+    {
+        std::cout << value << std::endl;
+    }
+
     list.insert_head(666);
     list.print();
 